@@ -49,11 +49,21 @@ typedef struct {
 	int count;
 } GameSet;
 
+typedef struct {
+	SDL_Surface* surface;
+	int x;
+} Viewport;
+
 typedef struct {
 	GameSet game_set;
 	const Uint8* keyboard;
 	SDL_Surface* window_surface;
+	Viewport viewport;
 	int index;
+	SDL_Thread* thread;
+	SDL_sem* start;
+	SDL_sem* done;
+	bool stop;
 } ThreadPackage;
 
 const char* const TITLE = "Space Defence 3 by Chigozie Agomo";
@@ -207,7 +217,13 @@ void spawn(GameSet game_set, SDL_Surface* window_surface) {
 	}
 }
 
-void update_shot(GameSet game_set, int index, SDL_Surface* window_surface) {
+void blit_viewport(SDL_Surface* surface, Viewport viewport, SDL_Rect* rect) {
+	rect->x -= viewport.x;
+	SDL_BlitSurface(surface, NULL, viewport.surface, rect);
+	rect->x += viewport.x;
+}
+
+void update_shot(GameSet game_set, int index, Viewport viewport) {
 	if (game_set.players[index].shot.active) {
 		game_set.players[index].shot.position[1] += SHOT_VELOCITY * (get_time() - game_set.players[index].shot.last_move);
 		game_set.players[index].shot.last_move = get_time();
@@ -219,7 +235,7 @@ void update_shot(GameSet game_set, int index, SDL_Surface* window_surface) {
 			.h = game_set.shot_surface->h
 		};
 		
-		SDL_BlitSurface(game_set.shot_surface, NULL, window_surface, &shot_rect);
+		blit_viewport(game_set.shot_surface, viewport, &shot_rect);
 		
 		for (int i = 0; i < game_set.enemy_containers[index].count; i++) {
 			SDL_Rect enemy_rect = {
@@ -259,14 +275,17 @@ void shoot(Player* player, SDL_Surface* window_surface) {
 	player->shot.last_move = get_time();
 }
 
-int update_thread(void* thread_package) {
-	GameSet game_set = ((ThreadPackage*) thread_package)->game_set;
-	const Uint8* keyboard = ((ThreadPackage*) thread_package)->keyboard;
-	SDL_Surface* window_surface = ((ThreadPackage*) thread_package)->window_surface;
-	int i = ((ThreadPackage*) thread_package)->index;
+void update_viewport(ThreadPackage* thread_package) {
+	GameSet game_set = thread_package->game_set;
+	const Uint8* keyboard = thread_package->keyboard;
+	SDL_Surface* window_surface = thread_package->window_surface;
+	Viewport viewport = thread_package->viewport;
+	int i = thread_package->index;
+	
+	SDL_BlitSurface(game_set.background_surface, NULL, viewport.surface, NULL);
 	
 	if (game_set.players[i].alive) {
-		update_shot(game_set, i, window_surface);
+		update_shot(game_set, i, viewport);
 		
 		switch (game_set.count) {
 			case 1:
@@ -349,7 +368,7 @@ int update_thread(void* thread_package) {
 			.h = game_set.player_surface->h
 		};
 		
-		SDL_BlitSurface(game_set.player_surface, NULL, window_surface, &player_rect);
+		blit_viewport(game_set.player_surface, viewport, &player_rect);
 		
 		for (int j = 0; j < game_set.enemy_containers[i].count; j++) {
 			game_set.enemy_containers[i].enemies[j].position[1] +=
@@ -364,7 +383,7 @@ int update_thread(void* thread_package) {
 				.h = game_set.enemy_surface->h
 			};
 			
-			SDL_BlitSurface(game_set.enemy_surface, NULL, window_surface, &enemy_rect);
+			blit_viewport(game_set.enemy_surface, viewport, &enemy_rect);
 			
 			if (
 				SDL_HasIntersection(&player_rect, &enemy_rect)
@@ -374,37 +393,106 @@ int update_thread(void* thread_package) {
 			}
 		}
 	}
+}
+
+int update_thread(void* thread_package) {
+	ThreadPackage* package = thread_package;
+	
+	while (true) {
+		SDL_SemWait(package->start);
+		
+		if (package->stop) {
+			break;
+		}
+		
+		update_viewport(package);
+		SDL_SemPost(package->done);
+	}
 	
 	return 0;
 }
 
-bool update2(GameSet game_set, const Uint8* keyboard, SDL_Surface* window_surface) {
-	SDL_Thread** threads = malloc(sizeof(SDL_Thread*) * game_set.count);
+SDL_Surface* copy_surface(SDL_Surface* surface) {
+	return SDL_ConvertSurface(surface, surface->format, 0);
+}
+
+ThreadPackage* start_threads(GameSet game_set, SDL_Surface* window_surface) {
 	ThreadPackage* thread_packages = malloc(sizeof(ThreadPackage) * game_set.count);
 	
 	for (int i = 0; i < game_set.count; i++) {
 		thread_packages[i].game_set = game_set;
-		thread_packages[i].keyboard = keyboard;
+		thread_packages[i].game_set.background_surface = copy_surface(game_set.background_surface);
+		thread_packages[i].game_set.player_surface = copy_surface(game_set.player_surface);
+		thread_packages[i].game_set.shot_surface = copy_surface(game_set.shot_surface);
+		thread_packages[i].game_set.enemy_surface = copy_surface(game_set.enemy_surface);
+		thread_packages[i].keyboard = NULL;
 		thread_packages[i].window_surface = window_surface;
+		thread_packages[i].viewport.surface = SDL_CreateRGBSurfaceWithFormat(
+			0, game_set.background_surface->w, window_surface->h,
+			window_surface->format->BitsPerPixel, window_surface->format->format
+		);
+		thread_packages[i].viewport.x = game_set.background_rects[i].x;
 		thread_packages[i].index = i;
-		threads[i] = SDL_CreateThread(update_thread, NULL, &thread_packages[i]);
+		thread_packages[i].start = SDL_CreateSemaphore(0);
+		thread_packages[i].done = SDL_CreateSemaphore(0);
+		thread_packages[i].stop = false;
+		
+		SDL_SetSurfaceBlendMode(thread_packages[i].game_set.background_surface, SDL_BLENDMODE_NONE);
+		SDL_SetSurfaceBlendMode(thread_packages[i].viewport.surface, SDL_BLENDMODE_NONE);
+		thread_packages[i].thread = SDL_CreateThread(update_thread, NULL, &thread_packages[i]);
+	}
+	
+	return thread_packages;
+}
+
+void stop_threads(ThreadPackage* thread_packages, int count) {
+	for (int i = 0; i < count; i++) {
+		thread_packages[i].stop = true;
+		SDL_SemPost(thread_packages[i].start);
+		SDL_WaitThread(thread_packages[i].thread, NULL);
+		
+		SDL_DestroySemaphore(thread_packages[i].done);
+		SDL_DestroySemaphore(thread_packages[i].start);
+		SDL_FreeSurface(thread_packages[i].viewport.surface);
+		SDL_FreeSurface(thread_packages[i].game_set.enemy_surface);
+		SDL_FreeSurface(thread_packages[i].game_set.shot_surface);
+		SDL_FreeSurface(thread_packages[i].game_set.player_surface);
+		SDL_FreeSurface(thread_packages[i].game_set.background_surface);
+	}
+	
+	free(thread_packages);
+}
+
+bool update2(ThreadPackage* thread_packages, int count, const Uint8* keyboard) {
+	for (int i = 0; i < count; i++) {
+		thread_packages[i].keyboard = keyboard;
+		SDL_SemPost(thread_packages[i].start);
 	}
 	
 	bool alive = false;
 	
-	for (int i = 0; i < game_set.count; i++) {
-		SDL_WaitThread(threads[i], NULL);
+	for (int i = 0; i < count; i++) {
+		SDL_SemWait(thread_packages[i].done);
 		
-		if (game_set.players[i].alive) {
+		if (thread_packages[i].game_set.players[i].alive) {
 			alive = true;
 		}
 	}
 	
-	free(threads);
-	free(thread_packages);
-	
 	return !alive;
 }
+
+void composite(ThreadPackage* thread_packages, int count, SDL_Surface* window_surface) {
+	for (int i = 0; i < count; i++) {
+		SDL_Rect rect = {
+			.x = thread_packages[i].viewport.x,
+			.y = 0
+		};
+		
+		SDL_BlitSurface(thread_packages[i].viewport.surface, NULL, window_surface, &rect);
+	}
+}
+
 bool update(GameSet game_set, const Uint8* keyboard, SDL_Surface* window_surface) {
 	bool alive = false;
 	
@@ -412,7 +500,7 @@ bool update(GameSet game_set, const Uint8* keyboard, SDL_Surface* window_surface
 		if (game_set.players[i].alive) {
 			alive = true;
 			
-			update_shot(game_set, i, window_surface);
+			update_shot(game_set, i, (Viewport) {.surface = window_surface, .x = 0});
 			
 			switch (game_set.count) {
 				case 1:
@@ -614,6 +702,8 @@ void game(SDL_Window* window, SDL_Surface* window_surface, int players) {
 	SDL_QueueAudio(audio_device, audio_buffer, audio_length);
 	double last_queue = get_time();
 	
+	ThreadPackage* thread_packages = start_threads(game_set, window_surface);
+	
 	while (!quit) {
 		initialise(&game_set, window_surface);
 		
@@ -630,7 +720,6 @@ void game(SDL_Window* window, SDL_Surface* window_surface, int players) {
 			);
 			
 			for (int i = 0; i < game_set.count; i++) {
-				SDL_BlitSurface(game_set.background_surface, NULL, window_surface, &game_set.background_rects[i]);
 				SDL_BlitSurface(game_set.score_surface, NULL, window_surface, &game_set.score_rects[i]);
 				
 				int score_copy[] = {
@@ -656,7 +745,10 @@ void game(SDL_Window* window, SDL_Surface* window_surface, int players) {
 			
 			const Uint8* keyboard = SDL_GetKeyboardState(NULL);
 			
-			if (update2(game_set, keyboard, window_surface)) {
+			bool over = update2(thread_packages, game_set.count, keyboard);
+			composite(thread_packages, game_set.count, window_surface);
+			
+			if (over) {
 				break;
 			}
 			
@@ -729,6 +821,8 @@ void game(SDL_Window* window, SDL_Surface* window_surface, int players) {
 		}
 	}
 	
+	stop_threads(thread_packages, game_set.count);
+	
 	SDL_CloseAudioDevice(audio_device);
 	SDL_FreeWAV(audio_buffer);
 	
@@ -0,0 +1,66 @@
+/**
+ * An offline tool that turns a gameplay capture from Recorder into footage.
+ * The capture is split at its key frames and the segments are decoded
+ *   on every CPU at once, so a long session is exported in a fraction
+ *   of the time it took to play.
+ * Build it alongside the game, with the same SDL2 and SDL2_net:
+ *   g++ -std=c++14 -O2 capturevideo.cpp -lSDL2 -lSDL2_net -o capturevideo
+ * Usage:
+ *   capturevideo <capture> <prefix> [threads]
+ *     writes the frames as <prefix>000000.bmp, <prefix>000001.bmp, ...
+ *   capturevideo --raw <capture> <output.rgb> [threads]
+ *     writes the frames as raw 24-bit RGB video, which can be encoded with:
+ *       ffmpeg -f rawvideo -pixel_format rgb24 -video_size <width>x<height>
+ *         -framerate 60 -i <output.rgb> <output.mp4>
+ * The threads default to one per CPU.
+ */
+
+#include <iostream>
+#include <string>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_net.h>
+#include "sdlandnet.hpp"
+
+/**
+ * Exports the capture passed on the command line.
+ */
+int main(int argc, char** argv) {
+    bool raw = argc > 1 && std::string(argv[1]) == "--raw";
+    int first = raw ? 2 : 1;
+
+    if (argc < first + 2 || argc > first + 3) {
+        std::cerr
+            << "Usage: " << argv[0] << " <capture> <prefix> [threads]\n"
+            << "       " << argv[0] << " --raw <capture> <output.rgb> [threads]\n"
+        ;
+        return 1;
+    }
+
+    System::initialise(System::NONE);
+    int status = 0;
+
+    try {
+        int threads = argc > first + 2 ? std::stoi(argv[first + 2]) : 0;
+        Uint32 start = SDL_GetTicks();
+        int frames = raw
+            ? Recorder::export_video(argv[first], argv[first + 1], threads)
+            : Recorder::export_frames(argv[first], argv[first + 1], threads)
+        ;
+
+        std::cout << frames << " frames exported in " << SDL_GetTicks() - start << " ms.\n";
+
+        if (raw) {
+            std::array<int, 2> size = Recorder::get_size(argv[first]);
+            std::cout << "Video size: " << size[0] << 'x' << size[1] << '\n';
+        }
+    }
+
+    catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        status = 1;
+    }
+
+    System::terminate();
+
+    return status;
+}
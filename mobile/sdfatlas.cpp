@@ -0,0 +1,372 @@
+/**
+ * An offline tool that builds a signed distance field atlas for SdfRenderer.
+ * Each glyph BMP is binarised, stretched to a square, supersampled,
+ *   and converted to a distance field with a two-pass sequential
+ *   Euclidean distance transform.
+ * The fields are stored left to right in one 8-bit greyscale BMP strip,
+ *   so the cell size is the strip's height and the glyph count is
+ *   the strip's width divided by its height.
+ * This tool has no dependencies, so it can be built anywhere:
+ *   g++ -std=c++14 -O2 sdfatlas.cpp -o sdfatlas
+ * Usage:
+ *   sdfatlas <output.bmp> <cell size> <glyph.bmp>...
+ * The glyphs must be given in the order of the characters passed to SdfRenderer.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+
+// Constants
+//{
+// The fraction of the cell size that the distance field spans on each side of an edge.
+// This must match SdfRenderer::SPREAD.
+constexpr double SPREAD = 0.125;
+
+// The distance field's resolution multiplier over the cell size.
+constexpr int SUPERSAMPLING = 8;
+
+// The brightness above which a glyph pixel is inside the glyph.
+constexpr int THRESHOLD = 0x7f;
+
+// The distance value of an edge.
+constexpr int EDGE = 0x80;
+
+// A distance greater than any in a supersampled cell.
+constexpr int FAR = 1 << 14;
+
+// BMP header constants.
+constexpr int FILE_HEADER_SIZE = 14;
+constexpr int INFO_HEADER_SIZE = 40;
+constexpr int PALETTE_SIZE = 256;
+//}
+
+// Classes
+//{
+/**
+ * A binary image loaded from a BMP file.
+ * Supports uncompressed 24-bit and 32-bit BMPs.
+ */
+class Mask {
+    public:
+        /**
+         * Loads the BMP at the given source and marks the bright pixels.
+         * Throws if the file is not a supported BMP.
+         */
+        Mask(const std::string& source) {
+            std::ifstream file(source, std::ios::binary);
+
+            if (!file) {
+                throw std::runtime_error(source + " could not be opened.");
+            }
+
+            std::vector<std::uint8_t> data(
+                (std::istreambuf_iterator<char>(file)),
+                std::istreambuf_iterator<char>()
+            );
+
+            if (data.size() < FILE_HEADER_SIZE + INFO_HEADER_SIZE || data[0] != 'B' || data[1] != 'M') {
+                throw std::runtime_error(source + " is not a BMP.");
+            }
+
+            int offset = read32(data, 10);
+            width = read32(data, 18);
+            height = read32(data, 22);
+            int depth = read16(data, 28);
+            int compression = read32(data, 30);
+
+            // Negative heights are stored top to bottom.
+            bool bottom_up = height > 0;
+            height = std::abs(height);
+
+            if ((depth != 24 && depth != 32) || compression != 0) {
+                throw std::runtime_error(source + " is not an uncompressed 24 or 32-bit BMP.");
+            }
+
+            int bytes = depth / 8;
+            int pitch = (width * bytes + 3) & ~3;
+
+            if (data.size() < offset + static_cast<std::size_t>(pitch) * height) {
+                throw std::runtime_error(source + " is truncated.");
+            }
+
+            inside.resize(width * height);
+
+            for (int y = 0; y < height; ++y) {
+                const std::uint8_t* row = data.data() + offset + (bottom_up ? height - 1 - y : y) * pitch;
+
+                for (int x = 0; x < width; ++x) {
+                    const std::uint8_t* pixel = row + x * bytes;
+                    inside[y * width + x] = std::max({pixel[0], pixel[1], pixel[2]}) > THRESHOLD;
+                }
+            }
+        }
+
+        /**
+         * Returns true if the pixel at the given ratios of
+         *   the width and height is inside the glyph.
+         */
+        bool sample(double x, double y) const noexcept {
+            int i = std::min(static_cast<int>(x * width), width - 1);
+            int j = std::min(static_cast<int>(y * height), height - 1);
+
+            return inside[j * width + i];
+        }
+
+    private:
+        /**
+         * Reads a little-endian 16-bit integer.
+         */
+        static int read16(const std::vector<std::uint8_t>& data, int offset) noexcept {
+            return data[offset] | data[offset + 1] << 8;
+        }
+
+        /**
+         * Reads a little-endian 32-bit integer.
+         */
+        static int read32(const std::vector<std::uint8_t>& data, int offset) noexcept {
+            return static_cast<std::int32_t>(
+                data[offset]
+                | data[offset + 1] << 8
+                | data[offset + 2] << 16
+                | static_cast<std::uint32_t>(data[offset + 3]) << 24
+            );
+        }
+
+        std::vector<bool> inside; // True for the pixels inside the glyph.
+        int width; // The width of the image.
+        int height; // The height of the image.
+};
+
+/**
+ * A grid of offsets to the nearest seed pixel.
+ * Used for the sequential Euclidean distance transform.
+ */
+class DistanceGrid {
+    public:
+        /**
+         * Constructs a grid where the pixels with the given
+         *   state in the mask are the seeds.
+         */
+        DistanceGrid(const std::vector<bool>& mask, int size, bool seed):
+            offsets(mask.size()),
+            size(size)
+        {
+            for (int i = 0; i < size * size; ++i) {
+                offsets[i] = mask[i] == seed ? Offset{0, 0} : Offset{FAR, FAR};
+            }
+
+            transform();
+        }
+
+        /**
+         * Returns the distance from the given pixel to the nearest seed.
+         */
+        double distance(int x, int y) const noexcept {
+            const Offset& offset = offsets[y * size + x];
+
+            return std::sqrt(static_cast<double>(offset.squared()));
+        }
+
+    private:
+        /**
+         * An offset to the nearest seed.
+         */
+        struct Offset {
+            int dx;
+            int dy;
+
+            long squared() const noexcept {
+                return static_cast<long>(dx) * dx + static_cast<long>(dy) * dy;
+            }
+        };
+
+        /**
+         * Replaces the pixel's offset with its neighbour's, if that is closer.
+         */
+        void compare(int x, int y, int dx, int dy) noexcept {
+            int nx = x + dx;
+            int ny = y + dy;
+
+            if (nx < 0 || ny < 0 || nx >= size || ny >= size) {
+                return;
+            }
+
+            Offset& offset = offsets[y * size + x];
+            Offset candidate = offsets[ny * size + nx];
+            candidate.dx += dx;
+            candidate.dy += dy;
+
+            if (candidate.squared() < offset.squared()) {
+                offset = candidate;
+            }
+        }
+
+        /**
+         * Propagates the offsets forwards and then backwards over the grid.
+         */
+        void transform() noexcept {
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    compare(x, y, -1, 0);
+                    compare(x, y, 0, -1);
+                    compare(x, y, -1, -1);
+                    compare(x, y, 1, -1);
+                }
+
+                for (int x = size - 1; x >= 0; --x) {
+                    compare(x, y, 1, 0);
+                }
+            }
+
+            for (int y = size - 1; y >= 0; --y) {
+                for (int x = size - 1; x >= 0; --x) {
+                    compare(x, y, 1, 0);
+                    compare(x, y, 0, 1);
+                    compare(x, y, -1, 1);
+                    compare(x, y, 1, 1);
+                }
+
+                for (int x = 0; x < size; ++x) {
+                    compare(x, y, -1, 0);
+                }
+            }
+        }
+
+        std::vector<Offset> offsets; // The offset of each pixel to its nearest seed.
+        int size; // The width and height of the grid.
+};
+//}
+
+// Functions
+//{
+/**
+ * Writes the distance field of the given glyph to its cell in the atlas.
+ * Inside distances are above EDGE and outside distances are below it.
+ */
+void build_cell(
+    const Mask& glyph,
+    std::vector<std::uint8_t>& atlas,
+    int index,
+    int count,
+    int cell
+) {
+    int size = cell * SUPERSAMPLING;
+    std::vector<bool> mask(size * size);
+
+    // The glyph is stretched to fill the supersampled square.
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            mask[y * size + x] = glyph.sample((x + 0.5) / size, (y + 0.5) / size);
+        }
+    }
+
+    DistanceGrid to_inside(mask, size, true);
+    DistanceGrid to_outside(mask, size, false);
+    double spread = SPREAD * size;
+
+    // Each cell pixel takes the signed distance at its centre.
+    for (int y = 0; y < cell; ++y) {
+        for (int x = 0; x < cell; ++x) {
+            int sx = x * SUPERSAMPLING + SUPERSAMPLING / 2;
+            int sy = y * SUPERSAMPLING + SUPERSAMPLING / 2;
+            double distance = to_outside.distance(sx, sy) - to_inside.distance(sx, sy);
+            int value = std::lround(EDGE + distance / spread * (EDGE - 1));
+            atlas[y * count * cell + index * cell + x] = std::min(std::max(value, 0), 0xff);
+        }
+    }
+}
+
+/**
+ * Writes the atlas as an 8-bit BMP with a greyscale palette.
+ */
+void save_atlas(
+    const std::string& destination,
+    const std::vector<std::uint8_t>& atlas,
+    int width,
+    int height
+) {
+    std::ofstream file(destination, std::ios::binary);
+
+    if (!file) {
+        throw std::runtime_error(destination + " could not be opened.");
+    }
+
+    int pitch = (width + 3) & ~3;
+    int offset = FILE_HEADER_SIZE + INFO_HEADER_SIZE + 4 * PALETTE_SIZE;
+    std::vector<std::uint8_t> header(offset);
+
+    auto write32 = [&header](int position, std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            header[position + i] = value >> 8 * i;
+        }
+    };
+
+    header[0] = 'B';
+    header[1] = 'M';
+    write32(2, offset + pitch * height);
+    write32(10, offset);
+    write32(14, INFO_HEADER_SIZE);
+    write32(18, width);
+    write32(22, height);
+    header[26] = 1;
+    header[28] = 8;
+    write32(46, PALETTE_SIZE);
+
+    for (int i = 0; i < PALETTE_SIZE; ++i) {
+        int entry = FILE_HEADER_SIZE + INFO_HEADER_SIZE + 4 * i;
+        header[entry] = i;
+        header[entry + 1] = i;
+        header[entry + 2] = i;
+    }
+
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+    // The rows are stored from bottom to top.
+    std::vector<char> row(pitch);
+
+    for (int y = height - 1; y >= 0; --y) {
+        std::copy(atlas.begin() + y * width, atlas.begin() + (y + 1) * width, row.begin());
+        file.write(row.data(), pitch);
+    }
+}
+//}
+
+/**
+ * Builds the atlas from the glyphs passed on the command line.
+ */
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <output.bmp> <cell size> <glyph.bmp>...\n";
+        return 1;
+    }
+
+    try {
+        int cell = std::stoi(argv[2]);
+        int count = argc - 3;
+
+        if (cell <= 0) {
+            throw std::runtime_error("The cell size must be positive.");
+        }
+
+        std::vector<std::uint8_t> atlas(count * cell * cell);
+
+        for (int i = 0; i < count; ++i) {
+            build_cell(Mask(argv[i + 3]), atlas, i, count, cell);
+        }
+
+        save_atlas(argv[1], atlas, count * cell, cell);
+    }
+
+    catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
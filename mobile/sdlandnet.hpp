@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <algorithm>
 #include <sstream>
 #include <memory>
 #include <array>
@@ -11,6 +12,8 @@
 #include <ctime>
 #include <limits>
 #include <random>
+#include <map>
+#include <cstdint>
 
 // System, Timer, and Random
 //{
@@ -20,7 +23,7 @@
 namespace System {
 	// The current version of the library.
 	constexpr int VERSION_LENGTH = 4;
-	constexpr int VERSION[VERSION_LENGTH] = {3, 0, 2, 0};
+	constexpr int VERSION[VERSION_LENGTH] = {3, 1, 0, 0};
 	
 	// The number of letters and numbers.
 	constexpr int LETTERS = 26;
@@ -103,6 +106,24 @@ namespace System {
 	int command(const std::string& command_string) noexcept {
 		return system(command_string.c_str());
 	}
+	
+	/**
+	 * Returns the directory where the given application can write files,
+	 *   ending in a path separator.
+	 * Returns an empty string if there is no such directory.
+	 */
+	std::string storage(const std::string& organisation, const std::string& application) noexcept {
+		char* path = SDL_GetPrefPath(organisation.c_str(), application.c_str());
+		
+		if (!path) {
+			return "";
+		}
+		
+		std::string storage(path);
+		SDL_free(path);
+		
+		return storage;
+	}
 }
 
 /**
@@ -420,6 +441,20 @@ namespace Events {
 	constexpr int SEMICOLON = SDL_SCANCODE_SEMICOLON;
 	constexpr int SLASH = SDL_SCANCODE_SLASH;
 	
+	// The ratios that mouse coordinates are multiplied by.
+	// Displays that render below their window's resolution set these,
+	//   so that mouse coordinates match the display's coordinates.
+	double mouse_x_scale = 1;
+	double mouse_y_scale = 1;
+	
+	/**
+	 * Sets the ratios that mouse coordinates are multiplied by.
+	 */
+	void set_mouse_scale(double x, double y) noexcept {
+		mouse_x_scale = x;
+		mouse_y_scale = y;
+	}
+	
 	/**
 	 * Updates the events.
 	 * Should be called for each event check loop.
@@ -471,7 +506,11 @@ namespace Events {
 	 * Fills in the integers passed with the mouse's coordinates.
 	 */
 	bool click(int button, int& x, int& y) noexcept {
-		return SDL_GetMouseState(&x, &y) & button;
+		bool state = SDL_GetMouseState(&x, &y) & button;
+		x = static_cast<int>(x * mouse_x_scale);
+		y = static_cast<int>(y * mouse_y_scale);
+		
+		return state;
 	}
 	
 	/**
@@ -638,10 +677,122 @@ class Messenger {
             // A C++ string is formed from the received message and returned.
 			return std::string(buffer.data());
 		}
+		
+		/**
+		 * Sends the string passed to the other messenger as a frame.
+		 * The frame is the string's length as a varint followed by the string,
+		 *   so nothing is padded, and it is sent in one write.
+		 * Throws an exception if the string is longer than MAX_FRAME,
+		 *   or if the frame could not be sent.
+		 */
+		void send_frame(const std::string& message) const {
+			// If the socket has not been initialised, an exception is thrown.
+			if (!socket) {
+				throw std::runtime_error("Uninitialised socket.");
+			}
+			
+			if (message.size() > static_cast<std::size_t>(MAX_FRAME)) {
+				throw std::runtime_error("The message is too long to be framed.");
+			}
+			
+			outgoing.clear();
+			append_length(outgoing, message.size());
+			outgoing.insert(outgoing.end(), message.begin(), message.end());
+			
+			if (SDLNet_TCP_Send(socket, outgoing.data(), outgoing.size()) < static_cast<int>(outgoing.size())) {
+				throw std::runtime_error("The frame could not be sent.");
+			}
+		}
+		
+		/**
+		 * Receives a frame sent by send_frame() into the given string,
+		 *   whose memory is reused if it is large enough.
+		 * Exactly one frame is read, however many reads TCP splits it across,
+		 *   so none of the next frame is consumed.
+		 * Throws an exception if the connection was closed,
+		 *   or if the frame is longer than MAX_FRAME.
+		 */
+		void read_frame(std::string& message) const {
+			// If the socket has not been initialised, an exception is thrown.
+			if (!socket) {
+				throw std::runtime_error("Uninitialised socket.");
+			}
+			
+			std::size_t length = 0;
+			unsigned char byte = 0x80;
+			
+			for (int shift = 0; byte & 0x80; shift += 7) {
+				if (shift > 28) {
+					throw std::runtime_error("The frame's length is invalid.");
+				}
+				
+				receive(&byte, 1);
+				length |= static_cast<std::size_t>(byte & 0x7f) << shift;
+			}
+			
+			if (length > static_cast<std::size_t>(MAX_FRAME)) {
+				throw std::runtime_error("The frame is too long.");
+			}
+			
+			message.resize(length);
+			
+			if (length) {
+				receive(&message[0], length);
+			}
+		}
+		
+		/**
+		 * Receives a frame sent by send_frame() and returns it.
+		 */
+		std::string read_frame() const {
+			std::string message;
+			read_frame(message);
+			
+			return message;
+		}
+
+		/**
+		 * Appends the given frame length to the buffer as a varint.
+		 * The length is stored 7 bits at a time, from the lowest,
+		 *   with the high bit set on all but the last byte.
+		 */
+		static void append_length(std::vector<char>& buffer, std::size_t length) {
+			for (; length >= 0x80; length >>= 7) {
+				buffer.push_back(static_cast<char>((length & 0x7f) | 0x80));
+			}
+			
+			buffer.push_back(static_cast<char>(length));
+		}
+		
+		/**
+		 * Reads a frame length stored by append_length() from the start of the given bytes.
+		 * Returns the number of bytes that it spans, 0 if the bytes end before it does,
+		 *   or -1 if it is longer than MAX_FRAME.
+		 */
+		static int parse_length(const char* bytes, std::size_t size, std::size_t& length) noexcept {
+			length = 0;
+			
+			for (std::size_t i = 0; i < size; i++) {
+				unsigned char byte = bytes[i];
+				length |= static_cast<std::size_t>(byte & 0x7f) << 7 * i;
+				
+				if (i > 4 || length > static_cast<std::size_t>(MAX_FRAME)) {
+					return -1;
+				}
+				
+				if (!(byte & 0x80)) {
+					return i + 1;
+				}
+			}
+			
+			return 0;
+		}
 
 		static constexpr int DEFAULT_READ = 1000; // Default max for read().
 		static constexpr int DEFAULT_PADDING = DEFAULT_READ; // Default min for send().
 		static constexpr char DEFAULT_PADDER = '\0'; // Default padder for send().
+		static constexpr int FRAMED = 0; // The MessengerPackage length for reading a frame.
+		static constexpr int MAX_FRAME = 1 << 24; // The maximum length of a framed message.
 		
 	protected:
 		/**
@@ -655,6 +806,28 @@ class Messenger {
 		TCPsocket socket = nullptr;  // The TCP socket used for the connection.
 		int padding; // The minimum width of messages sent by default.
 		char padder; // The character used to pad the messages sent.
+		
+	private:
+		/**
+		 * Reads exactly the given number of bytes, across partial reads.
+		 * Throws an exception if the connection was closed first.
+		 */
+		void receive(void* data, std::size_t length) const {
+			char* bytes = static_cast<char*>(data);
+			
+			while (length) {
+				int received = SDLNet_TCP_Recv(socket, bytes, length);
+				
+				if (received <= 0) {
+					throw std::runtime_error("The connection was closed.");
+				}
+				
+				bytes += received;
+				length -= received;
+			}
+		}
+		
+		mutable std::vector<char> outgoing; // The buffer that frames are assembled in by send_frame().
 };
 
 /**
@@ -849,6 +1022,7 @@ class MessengerPackage {
 		/**
 		 * Takes the messenger, the string to overwrite, and the
 		 *   maximum string length to construct a thread package.
+		 * A length of Messenger::FRAMED reads a frame sent by send_frame().
 		 */
 		MessengerPackage(
 			const Messenger& m,
@@ -901,7 +1075,20 @@ class MessengerPackage {
 			int length = package.get_length();
 			
 			// The string's contents are updated with the received string.
-			string = messenger.read(length);
+			// A frame is read into the string's memory, and a closed connection empties it.
+			if (length == Messenger::FRAMED) {
+				try {
+					messenger.read_frame(string);
+				}
+				
+				catch (const std::exception&) {
+					string.clear();
+				}
+			}
+			
+			else {
+				string = messenger.read(length);
+			}
 			
 			return 0;
 		}
@@ -1059,6 +1246,306 @@ class Bridge {
 		const Messenger& destination; // The messenger connected to the destination.
 		std::string terminator;       // The string that terminates the thread.
 };
+
+/**
+ * An abstract base class for a server that many clients connect to at once.
+ * The listening socket and every client's socket are kept in a socket set,
+ *   so all of them are serviced by one thread, which waits on them together.
+ * Clients exchange frames, as sent by Messenger::send_frame(),
+ *   and each complete frame is passed to handle() with the client's number.
+ * Reads never block, but SDL_net's sends do, so a client that stops
+ *   reading stalls the thread, and every other client, once its socket's
+ *   buffer fills. Replies should be kept small.
+ */
+class MultiServer {
+	public:
+		/**
+		 * Opens the server at localhost:[port] for up to the given number of clients.
+		 * Clients that connect while the server is full are disconnected.
+		 * Throws an exception if the port cannot be opened.
+		 */
+		MultiServer(int port, int capacity = DEFAULT_CAPACITY):
+			capacity(std::max(capacity, 1))
+		{
+			IPaddress ip_address;
+			SDLNet_ResolveHost(&ip_address, nullptr, port);
+			
+			// If the port cannot be opened, an exception is thrown.
+			if (!(server = SDLNet_TCP_Open(&ip_address))) {
+				throw std::runtime_error("The port cannot be opened.");
+			}
+			
+			// The set has room for the listening socket and every client.
+			if (!(sockets = SDLNet_AllocSocketSet(this->capacity + 1))) {
+				SDLNet_TCP_Close(server);
+				throw std::runtime_error("The socket set could not be allocated.");
+			}
+			
+			SDLNet_TCP_AddSocket(sockets, server);
+			SDL_AtomicSet(&running, 1);
+		}
+		
+		/**
+		 * Instances of this class are not safe to copy.
+		 */
+		MultiServer(const MultiServer&) = delete;
+		
+		/**
+		 * Closes the sockets of the server and its clients.
+		 */
+		virtual ~MultiServer() noexcept {
+			for (auto& client: clients) {
+				SDLNet_TCP_Close(client.second.socket);
+			}
+			
+			SDLNet_TCP_Close(server);
+			SDLNet_FreeSocketSet(sockets);
+		}
+		
+		/**
+		 * Instances of this class are not safe to copy.
+		 */
+		MultiServer& operator=(const MultiServer&) = delete;
+		
+		/**
+		 * Waits up to the given number of milliseconds for any socket to be ready,
+		 *   then accepts new clients and passes every complete frame received to handle().
+		 * Partial frames are kept until the rest arrives, so a slow client never stalls the others.
+		 * Clients that disconnect or send an invalid frame are closed.
+		 * Returns the number of frames handled.
+		 */
+		int service(Uint32 timeout = 0) noexcept {
+			// Clients disconnected since the last service are closed, even if no socket is ready.
+			if (SDLNet_CheckSockets(sockets, timeout) <= 0) {
+				close_clients();
+				return 0;
+			}
+			
+			int handled = 0;
+			
+			for (auto& client: clients) {
+				Connection& connection = client.second;
+				
+				if (connection.open && SDLNet_SocketReady(connection.socket)) {
+					handled += receive(client.first, connection);
+				}
+			}
+			
+			if (SDLNet_SocketReady(server)) {
+				accept();
+			}
+			
+			close_clients();
+			
+			return handled;
+		}
+		
+		/**
+		 * Sends the string to the given client as a frame.
+		 * This should only be called on the thread servicing the server, as by handle().
+		 * This blocks until the frame is sent, which stalls every other client
+		 *   if this client has stopped reading and its socket's buffer is full.
+		 * Returns false if there is no such client or the frame could not be sent,
+		 *   in which case the client is disconnected by the next service().
+		 */
+		bool send(int client, const std::string& message) noexcept {
+			auto found = clients.find(client);
+			
+			if (found == clients.end() || !found->second.open || message.size() > static_cast<std::size_t>(Messenger::MAX_FRAME)) {
+				return false;
+			}
+			
+			outgoing.clear();
+			Messenger::append_length(outgoing, message.size());
+			outgoing.insert(outgoing.end(), message.begin(), message.end());
+			
+			if (SDLNet_TCP_Send(found->second.socket, outgoing.data(), outgoing.size()) < static_cast<int>(outgoing.size())) {
+				found->second.open = false;
+				return false;
+			}
+			
+			return true;
+		}
+		
+		/**
+		 * Sends the string to every client as a frame.
+		 * The frame is sent to each client in turn, as by send(),
+		 *   so one client that has stopped reading stalls the rest.
+		 * Returns the number of clients that it was sent to.
+		 */
+		int broadcast(const std::string& message) noexcept {
+			int sent = 0;
+			
+			for (auto& client: clients) {
+				sent += send(client.first, message);
+			}
+			
+			return sent;
+		}
+		
+		/**
+		 * Disconnects the given client at the end of the current or next service().
+		 */
+		void disconnect(int client) noexcept {
+			auto found = clients.find(client);
+			
+			if (found != clients.end()) {
+				found->second.open = false;
+			}
+		}
+		
+		/**
+		 * Returns the number of clients connected.
+		 */
+		int get_clients() const noexcept {
+			return clients.size();
+		}
+		
+		/**
+		 * Makes serve() return after its current service().
+		 */
+		void stop() noexcept {
+			SDL_AtomicSet(&running, 0);
+		}
+		
+		/**
+		 * A static method suitable for use with the Thread class.
+		 * This method services the given MultiServer until stop() is called,
+		 *   so every client is handled by this one thread.
+		 */
+		static int serve(void* data) noexcept {
+			MultiServer& server = *static_cast<MultiServer*>(data);
+			
+			while (SDL_AtomicGet(&server.running)) {
+				server.service(SERVICE_TIMEOUT);
+			}
+			
+			return 0;
+		}
+		
+		static constexpr int DEFAULT_CAPACITY = 256;  // Default maximum number of clients.
+		static constexpr Uint32 SERVICE_TIMEOUT = 50; // The milliseconds that serve() waits for sockets.
+		
+	protected:
+		/**
+		 * Called with a complete frame received from the given client.
+		 * Clients are numbered from 0 in the order that they connect,
+		 *   and numbers are not reused.
+		 */
+		virtual void handle(int client, const std::string& message) noexcept = 0;
+		
+		/**
+		 * Called when the given client connects.
+		 */
+		virtual void connected(int) noexcept {}
+		
+		/**
+		 * Called when the given client has been disconnected.
+		 */
+		virtual void disconnected(int) noexcept {}
+		
+	private:
+		/**
+		 * A connected client and the bytes received from it that are not yet handled.
+		 */
+		struct Connection {
+			TCPsocket socket;           // The client's socket.
+			std::vector<char> incoming; // The start of a frame that is still arriving.
+			bool open;                  // False if the client should be disconnected.
+		};
+		
+		/**
+		 * Accepts a waiting client, or disconnects it if the server is full.
+		 */
+		void accept() noexcept {
+			TCPsocket socket = SDLNet_TCP_Accept(server);
+			
+			if (!socket) {
+				return;
+			}
+			
+			if (static_cast<int>(clients.size()) >= capacity) {
+				SDLNet_TCP_Close(socket);
+				return;
+			}
+			
+			SDLNet_TCP_AddSocket(sockets, socket);
+			clients[next_client] = {socket, {}, true};
+			connected(next_client++);
+		}
+		
+		/**
+		 * Reads what the given client has sent and handles every complete frame.
+		 * The ready socket is read once, so this doesn't block.
+		 * Returns the number of frames handled.
+		 */
+		int receive(int client, Connection& connection) noexcept {
+			std::vector<char>& incoming = connection.incoming;
+			std::size_t size = incoming.size();
+			incoming.resize(size + READ_SIZE);
+			int received = SDLNet_TCP_Recv(connection.socket, incoming.data() + size, READ_SIZE);
+			
+			if (received <= 0) {
+				connection.open = false;
+				return 0;
+			}
+			
+			incoming.resize(size + received);
+			std::size_t start = 0;
+			int handled = 0;
+			
+			while (connection.open && start < incoming.size()) {
+				std::size_t length;
+				int prefix = Messenger::parse_length(incoming.data() + start, incoming.size() - start, length);
+				
+				if (prefix < 0) {
+					connection.open = false;
+				}
+				
+				if (prefix <= 0 || incoming.size() - start - prefix < length) {
+					break;
+				}
+				
+				message.assign(incoming.data() + start + prefix, length);
+				start += prefix + length;
+				handle(client, message);
+				handled++;
+			}
+			
+			incoming.erase(incoming.begin(), incoming.begin() + start);
+			
+			return handled;
+		}
+		
+		/**
+		 * Closes the clients that were disconnected.
+		 */
+		void close_clients() noexcept {
+			for (auto client = clients.begin(); client != clients.end(); ) {
+				if (client->second.open) {
+					++client;
+					continue;
+				}
+				
+				int number = client->first;
+				SDLNet_TCP_DelSocket(sockets, client->second.socket);
+				SDLNet_TCP_Close(client->second.socket);
+				client = clients.erase(client);
+				disconnected(number);
+			}
+		}
+		
+		static constexpr int READ_SIZE = 4096; // The maximum number of bytes read from a client at once.
+		
+		TCPsocket server = nullptr;         // The listening socket.
+		SDLNet_SocketSet sockets = nullptr; // The listening socket and the clients' sockets.
+		std::map<int, Connection> clients;  // The connected clients by number.
+		int capacity;                       // The maximum number of clients.
+		int next_client = 0;                // The number of the next client to connect.
+		std::string message;                // The frame passed to handle().
+		std::vector<char> outgoing;         // The buffer that frames are assembled in by send().
+		SDL_atomic_t running = {};          // Nonzero until stop() is called.
+};
 //}
 
 // Shape Classes
@@ -1465,1419 +1952,5886 @@ class Circle: public Shape {
 
 // Video and Audio Classes
 //{
+class Sprite;
+
 /**
- * A wrapper class for SDL_Surfaces.
- * Manages the blitting of one surface to another.
- * Also allows for the surface or a rectangular section
- *   of it to be filled in with a single colour.
- * Instances of this class are not copiable, but are movable.
+ * A registry of unscaled blit kernels, specialised at compile time
+ *   for their source and destination formats and blend mode.
+ * Each kernel copies rows in blocks of a fixed number of pixels,
+ *   so the compiler unrolls and vectorises the inner loop, and
+ *   finishes each row with a loop over the remaining pixels.
+ * The kernel for a blit is looked up by its formats and mode, with
+ *   the largest block that fits in the blit's width, so sprites of
+ *   a fixed size always take the same tight loop.
+ * Kernels for the common 32-bit and high colour formats are registered
+ *   on first use, and more can be registered with add().
  */
-class Sprite {
+class Blitter {
 	public:
 		/**
-		 * An enumeration of various predefined colours.
-		 * Used with the sprite filling methods.
+		 * The ways a kernel combines a source pixel with a destination pixel.
 		 */
-		enum Colour {
-			BLACK,   // 000000
-			GREY,    // 7f7f7f
-			WHITE,   // ffffff
-			RED,     // ff0000
-			YELLOW,  // ffff00
-			GREEN,   // 00ff00
-			CYAN,    // 00ffff
-			BLUE,    // 0000ff
-			MAGENTA  // ff00ff
+		enum Mode {
+			COPY,  // The source replaces the destination.
+			KEY,   // As COPY, except for pixels matching the colour key.
+			BLEND  // The source is blended by its alpha.
 		};
 		
 		/**
-		 * Constructs a new Sprite object using the given surface.
+		 * A kernel that blits the given number of pixels in each of the
+		 *   given number of rows, from the source rows to the destination
+		 *   rows, skipping pixels equal to the given key in KEY mode.
 		 */
-		Sprite(SDL_Surface* surf) noexcept {
-			surface = surf;
-		}
+		using Kernel = void (*)(
+			const Uint8* source,
+			int source_pitch,
+			Uint8* destination,
+			int destination_pitch,
+			int width,
+			int height,
+			Uint32 key
+		);
 		
 		/**
-		 * Constructs a new Sprite object.
-		 * The Sprite is created with the given dimenions.
+		 * 32-bit ARGB pixels.
+		 * All formats are converted through this one.
 		 */
-		Sprite(int width = 0, int height = 0) noexcept {
-			create_surface(width, height);
-		}
-		
-		/**
-		 * Constructs a new Sprite object.
-		 * The Sprite is created with the given dimenions.
-		 * The Sprite is filled in with the given colour.
-		 */
-		Sprite(int width, int height, int red, int green, int blue) noexcept {
-			create_surface(width, height);
-			fill(red, green, blue);
-		}
+		struct Argb8888 {
+			using Pixel = Uint32;
+			static constexpr Uint32 FORMAT = SDL_PIXELFORMAT_ARGB8888;
+			
+			static Uint32 to_argb(Pixel pixel) noexcept {
+				return pixel;
+			}
+			
+			static Pixel from_argb(Uint32 pixel) noexcept {
+				return pixel;
+			}
+		};
 		
 		/**
-		 * Constructs a new Sprite object.
-		 * The Sprite is created with the given dimenions.
-		 * The Sprite is filled in with the given greyscale shade.
+		 * 32-bit RGB pixels, with the top byte unused.
 		 */
-		Sprite(int width, int height, int brightness) noexcept {
-			create_surface(width, height);
-			fill(brightness, brightness, brightness);
-		}
+		struct Rgb888 {
+			using Pixel = Uint32;
+			static constexpr Uint32 FORMAT = SDL_PIXELFORMAT_RGB888;
+			
+			static Uint32 to_argb(Pixel pixel) noexcept {
+				return pixel | 0xff000000;
+			}
+			
+			static Pixel from_argb(Uint32 pixel) noexcept {
+				return pixel & 0xffffff;
+			}
+		};
 		
 		/**
-		 * Constructs a new Sprite object.
-		 * The Sprite is created with the given dimenions.
-		 * The Sprite is filled in with the given colour.
-		 * Uses predefined colours.
+		 * 32-bit ABGR pixels, which are RGBA bytes in little-endian order.
 		 */
-		Sprite(int width, int height, Colour colour) noexcept {
-			create_surface(width, height);
-			fill(colour);
-		}
+		struct Abgr8888 {
+			using Pixel = Uint32;
+			static constexpr Uint32 FORMAT = SDL_PIXELFORMAT_ABGR8888;
+			
+			static Uint32 to_argb(Pixel pixel) noexcept {
+				return (pixel & 0xff00ff00) | (pixel & 0xff) << 16 | (pixel >> 16 & 0xff);
+			}
+			
+			static Pixel from_argb(Uint32 pixel) noexcept {
+				return to_argb(pixel);
+			}
+		};
 		
 		/**
-		 * Constructs a new Sprite object.
-		 * The Sprite is loaded from the BMP file passed in
-		 *   string form and is not scaled.
+		 * 16-bit high colour pixels.
+		 * Channels are widened by repeating their top bits.
 		 */
-		Sprite(const std::string& source) {
-			surface = SDL_LoadBMP(source.c_str());
-            
-            // An exception is thrown, if the surface couldn't be loaded.
-            if (!surface) {
-                throw std::runtime_error(source + " could not be opened.");
-            }
-            
-			allocated = true;
-		}
+		struct Rgb565 {
+			using Pixel = Uint16;
+			static constexpr Uint32 FORMAT = SDL_PIXELFORMAT_RGB565;
+			
+			static Uint32 to_argb(Pixel pixel) noexcept {
+				Uint32 red = pixel >> 11;
+				Uint32 green = pixel >> 5 & 0x3f;
+				Uint32 blue = pixel & 0x1f;
+				
+				return
+					0xff000000
+					| (red << 3 | red >> 2) << 16
+					| (green << 2 | green >> 4) << 8
+					| (blue << 3 | blue >> 2)
+				;
+			}
+			
+			static Pixel from_argb(Uint32 pixel) noexcept {
+				return (pixel >> 8 & 0xf800) | (pixel >> 5 & 0x7e0) | (pixel >> 3 & 0x1f);
+			}
+		};
 		
 		/**
-		 * Constructs a new Sprite object.
-		 * The Sprite is loaded from the BMP file passed in
-		 *   string form and scaled to the given dimensions.
+		 * Returns the kernel for blits of the given width between the given
+		 *   formats in the given mode, or nullptr if there is none.
 		 */
-		Sprite(const std::string& source, int width, int height) {
-			SDL_Surface* raw_surface = SDL_LoadBMP(source.c_str());
-            
-            // An exception is thrown, if the surface couldn't be loaded.
-            if (!raw_surface) {
-                throw std::runtime_error(source + " could not be opened.");
-            }
-            
-			create_surface(width, height);
-			SDL_BlitScaled(raw_surface, nullptr, surface, nullptr);
-			SDL_FreeSurface(raw_surface);
+		static Kernel find(Uint32 source, Uint32 destination, Mode mode, int width) noexcept {
+			const Registry& registry = get_registry();
+			auto kernel = registry.find({source, destination, static_cast<Uint32>(mode), block(width)});
+			
+			return kernel == registry.end() ? nullptr : kernel->second;
 		}
 		
-        /**
-		 * Constructs a new Sprite object.
-		 * The Sprite is loaded from the BMP file passed in
-		 *   string form and scaled to the given dimensions.
-         * The size of the sprite is a ratio of the given sprite.
-		 */
-        Sprite(
-            const std::string& source,
-            const Sprite& stemplate,
-            double width,
-            double height
-        ):
-            Sprite(
-                source,
-                width * stemplate.width(),
-                height * stemplate.height()
-            )
-        {}
-        
 		/**
-		 * Copying a sprite can be done safely using blitting.
+		 * Registers the kernels between the given formats in the given mode,
+		 *   for every block size.
+		 * Kernels should be registered before blitting from multiple threads.
 		 */
-		Sprite(const Sprite& sprite) noexcept {
-			operator=(sprite);
+		template <typename Source, typename Destination, Mode MODE>
+		static void add() noexcept {
+			add<Source, Destination, MODE>(get_registry());
 		}
 		
+	private:
+		using Registry = std::map<std::array<Uint32, 4>, Kernel>;
+		
 		/**
-		 * Sprites can be moved safely.
+		 * Registers the kernels between the given formats in the given mode
+		 *   in the given registry, for every block size.
 		 */
-		Sprite(Sprite&& sprite) noexcept {
-			operator=(std::move(sprite));
+		template <typename Source, typename Destination, Mode MODE>
+		static void add(Registry& registry) noexcept {
+			registry[{Source::FORMAT, Destination::FORMAT, MODE, 1}] = kernel<Source, Destination, MODE, 1>;
+			registry[{Source::FORMAT, Destination::FORMAT, MODE, 8}] = kernel<Source, Destination, MODE, 8>;
+			registry[{Source::FORMAT, Destination::FORMAT, MODE, 16}] = kernel<Source, Destination, MODE, 16>;
+			registry[{Source::FORMAT, Destination::FORMAT, MODE, 32}] = kernel<Source, Destination, MODE, 32>;
+			registry[{Source::FORMAT, Destination::FORMAT, MODE, 64}] = kernel<Source, Destination, MODE, 64>;
 		}
 		
 		/**
-		 * Frees the mmeory dynamically allocated to the surface
-		 *   if it was allocated in this class.
+		 * Blits the rows in blocks of BLOCK pixels and then the rest of each row.
+		 * The block's loop has a fixed length, so it is unrolled and vectorised.
 		 */
-		~Sprite() noexcept {
-			destroy_surface();
+		template <typename Source, typename Destination, Mode MODE, int BLOCK>
+		static void kernel(
+			const Uint8* source,
+			int source_pitch,
+			Uint8* destination,
+			int destination_pitch,
+			int width,
+			int height,
+			Uint32 key
+		) {
+			using In = typename Source::Pixel;
+			using Out = typename Destination::Pixel;
+			In raw_key = static_cast<In>(key);
+			int blocks = width - width % BLOCK;
+			
+			for (int y = 0; y < height; y++) {
+				const In* in = reinterpret_cast<const In*>(source + y * source_pitch);
+				Out* out = reinterpret_cast<Out*>(destination + y * destination_pitch);
+				int x = 0;
+				
+				for (; x < blocks; x += BLOCK) {
+					for (int i = 0; i < BLOCK; i++) {
+						out[x + i] = pixel<Source, Destination, MODE>(in[x + i], out[x + i], raw_key);
+					}
+				}
+				
+				for (; x < width; x++) {
+					out[x] = pixel<Source, Destination, MODE>(in[x], out[x], raw_key);
+				}
+			}
 		}
 		
 		/**
-		 * Initialises the sprite with the given surface.
+		 * Returns the destination pixel combined with the source pixel.
+		 * The mode is known at compile time, so only one branch remains.
 		 */
-		Sprite& operator=(SDL_Surface* surf) noexcept {
-			destroy_surface();
-			surface = surf;
+		template <typename Source, typename Destination, Mode MODE>
+		static typename Destination::Pixel pixel(
+			typename Source::Pixel in,
+			typename Destination::Pixel out,
+			typename Source::Pixel key
+		) noexcept {
+			if (MODE == KEY) {
+				return in == key ? out : Destination::from_argb(Source::to_argb(in));
+			}
 			
-			return *this;
+			if (MODE == BLEND) {
+				return Destination::from_argb(blend(Source::to_argb(in), Destination::to_argb(out)));
+			}
+			
+			return Destination::from_argb(Source::to_argb(in));
 		}
 		
 		/**
-		 * Copying a sprite can be done safely using blitting.
+		 * Blends the given ARGB source pixel over the given ARGB destination pixel by its alpha.
+		 * Red and blue are blended in one multiply and green in another.
 		 */
-		Sprite& operator=(const Sprite& sprite) noexcept {
-			create_surface(sprite.surface->w, sprite.surface->h);
-			blit(sprite, 0, 0);
+		static Uint32 blend(Uint32 source, Uint32 destination) noexcept {
+			Uint32 alpha = source >> 24;
+			Uint32 inverse = 0xff - alpha;
+			Uint32 red_blue = (source & 0xff00ff) * alpha + (destination & 0xff00ff) * inverse;
+			Uint32 green = ((source & 0xff00) * alpha + (destination & 0xff00) * inverse) >> 8;
+			Uint32 opacity = alpha * 0xff + (destination >> 24) * inverse;
 			
-			return *this;
+			return divide(opacity) << 24 | divide(red_blue) | divide(green) << 8;
 		}
 		
 		/**
-		 * Sprites can be moved safely.
+		 * Divides each 16-bit lane of the given value by 255.
+		 * Each lane must be at most 255 * 255.
 		 */
-		Sprite& operator=(Sprite&& sprite) noexcept {
-			destroy_surface();
-			surface = sprite.surface;
-			allocated = sprite.allocated;
-			sprite.allocated = false;
-			
-			return *this;
+		static Uint32 divide(Uint32 lanes) noexcept {
+			return (lanes + 0x10001 + (lanes >> 8 & 0xff00ff)) >> 8 & 0xff00ff;
 		}
 		
 		/**
-		 * Returns the width of the sprite.
+		 * Returns the block size of the kernels for blits of the given width.
 		 */
-		int width() const noexcept {
-			return get_width();
+		static Uint32 block(int width) noexcept {
+			return width >= 64 ? 64 : width >= 32 ? 32 : width >= 16 ? 16 : width >= 8 ? 8 : 1;
 		}
-		 
+		
 		/**
-		 * Returns the height of the sprite.
+		 * Registers the kernels from the given source format to
+		 *   each destination format in the given registry.
+		 * Sources with alpha also get blending kernels.
 		 */
-		int height() const noexcept {
-			return get_height();
+		template <typename Source>
+		static void add_source(Registry& registry, bool alpha) noexcept {
+			add<Source, Argb8888, COPY>(registry);
+			add<Source, Argb8888, KEY>(registry);
+			add<Source, Rgb888, COPY>(registry);
+			add<Source, Rgb888, KEY>(registry);
+			add<Source, Abgr8888, COPY>(registry);
+			add<Source, Abgr8888, KEY>(registry);
+			add<Source, Rgb565, COPY>(registry);
+			add<Source, Rgb565, KEY>(registry);
+			
+			if (alpha) {
+				add<Source, Argb8888, BLEND>(registry);
+				add<Source, Rgb888, BLEND>(registry);
+				add<Source, Abgr8888, BLEND>(registry);
+				add<Source, Rgb565, BLEND>(registry);
+			}
 		}
 		
 		/**
-		 * Returns the width of the sprite.
+		 * Returns the registry, filled with the default kernels on first use.
+		 * The registry is never destroyed, so sprites blitted
+		 *   during static destruction can still use it.
 		 */
-		int get_width() const noexcept {
-			return surface->w;
+		static Registry& get_registry() noexcept {
+			static Registry* registry = create();
+			
+			return *registry;
 		}
 		
 		/**
-		 * Returns the height of the sprite.
+		 * Returns a new registry of the default kernels.
 		 */
-		int get_height() const noexcept {
-			return surface->h;
+		static Registry* create() noexcept {
+			Registry* registry = new Registry;
+			add_source<Argb8888>(*registry, true);
+			add_source<Abgr8888>(*registry, true);
+			add_source<Rgb888>(*registry, false);
+			add_source<Rgb565>(*registry, false);
+			
+			return registry;
 		}
-		
+};
+
+/**
+ * A pool of recycled surfaces, bucketed by size and pixel format.
+ * Sprites take the surfaces they create from the pool and return them
+ *   when they are destroyed, so short-lived sprites, such as rendered
+ *   text, reuse the pixels of earlier ones instead of allocating.
+ * At most CAPACITY bytes of pixels are kept and surfaces past this are freed.
+ * The pool is safe to use from multiple threads.
+ */
+class SurfacePool {
+	public:
 		/**
-		 * Fills in the sprite with the given RGB colour.
+		 * Returns a surface of the given size and pixel format, with every pixel zeroed.
+		 * A recycled surface is returned, if the pool has one,
+		 *   and a new one is created otherwise.
 		 */
-		void fill(int red, int green, int blue) noexcept {
-			SDL_FillRect(
-				surface, nullptr,
-				SDL_MapRGB(surface->format, red, green, blue)
-			);
+		static SDL_Surface* create(int width, int height, Uint32 format) noexcept {
+			Pool& pool = get_pool();
+			SDL_Surface* surface = nullptr;
+			
+			SDL_AtomicLock(&pool.lock);
+			auto bucket = pool.buckets.find({
+				static_cast<Uint32>(width),
+				static_cast<Uint32>(height),
+				format
+			});
+			
+			if (bucket != pool.buckets.end() && !bucket->second.empty()) {
+				surface = bucket->second.back();
+				bucket->second.pop_back();
+				pool.bytes -= size(surface);
+				pool.hits++;
+			}
+			
+			else {
+				pool.misses++;
+			}
+			
+			SDL_AtomicUnlock(&pool.lock);
+			
+			if (!surface) {
+				return SDL_CreateRGBSurfaceWithFormat(0, width, height, SDL_BITSPERPIXEL(format), format);
+			}
+			
+			Uint8* pixels = static_cast<Uint8*>(surface->pixels);
+			std::fill(pixels, pixels + size(surface), 0);
+			
+			return surface;
 		}
 		
 		/**
-		 * Fills in the sprite with a grayscale shade.
+		 * Returns the given surface to the pool, or frees it.
+		 * The surface's clip, colour key, blending and modulation are reset.
+		 * Surfaces that are shared, paletted, run-length encoded or that
+		 *   don't own their pixels are freed, as are those that don't fit.
 		 */
-		void fill(int brightness) noexcept {
-			fill(brightness, brightness, brightness);
+		static void recycle(SDL_Surface* surface) noexcept {
+			if (
+				!surface
+				|| surface->refcount != 1
+				|| surface->flags & (SDL_PREALLOC | SDL_RLEACCEL | SDL_DONTFREE)
+				|| surface->format->palette
+			) {
+				SDL_FreeSurface(surface);
+				return;
+			}
+			
+			SDL_SetClipRect(surface, nullptr);
+			SDL_SetColorKey(surface, SDL_FALSE, 0);
+			SDL_SetSurfaceRLE(surface, 0);
+			
+			// New surfaces only blend if they have an alpha channel.
+			SDL_SetSurfaceBlendMode(surface, surface->format->Amask ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+			SDL_SetSurfaceAlphaMod(surface, 0xff);
+			SDL_SetSurfaceColorMod(surface, 0xff, 0xff, 0xff);
+			
+			Pool& pool = get_pool();
+			bool kept = false;
+			
+			SDL_AtomicLock(&pool.lock);
+			
+			if (pool.bytes + size(surface) <= CAPACITY) {
+				pool.buckets[{
+					static_cast<Uint32>(surface->w),
+					static_cast<Uint32>(surface->h),
+					surface->format->format
+				}].push_back(surface);
+				pool.bytes += size(surface);
+				kept = true;
+			}
+			
+			SDL_AtomicUnlock(&pool.lock);
+			
+			if (!kept) {
+				SDL_FreeSurface(surface);
+			}
 		}
 		
 		/**
-		 * Fills in the sprite with a predefined colour.
+		 * Frees every surface in the pool.
 		 */
-		void fill(Colour colour = BLACK) noexcept {
-			std::array<int, 3> rgb = to_rgb(colour);
-			fill(rgb[0], rgb[1], rgb[2]);
+		static void clear() noexcept {
+			Pool& pool = get_pool();
+			
+			SDL_AtomicLock(&pool.lock);
+			pool.clear();
+			SDL_AtomicUnlock(&pool.lock);
 		}
 		
 		/**
-		 * Fills in the sprite in the area defined by the given rectangle.
+		 * Returns the number of surfaces that were taken from the pool.
 		 */
-		void fill(const Rectangle& rectangle, int red, int green, int blue) noexcept {
-			SDL_FillRect(
-				surface, rectangle.get(),
-				SDL_MapRGB(surface->format, red, green, blue)
-			);
+		static int get_hits() noexcept {
+			return get_pool().hits;
 		}
 		
 		/**
-		 * Fills in the sprite in the area defined by the given rectangle.
-		 * The sprite is filled in with a grayscale shade.
+		 * Returns the number of surfaces that had to be created.
 		 */
-		void fill(const Rectangle& rectangle, int brightness) noexcept {
-			fill(rectangle, brightness, brightness, brightness);
+		static int get_misses() noexcept {
+			return get_pool().misses;
 		}
 		
 		/**
-		 * Fills in the sprite in the area defined by the given rectangle.
-		 * Uses predefined colours.
+		 * Returns the number of bytes of pixels in the pool.
 		 */
-		void fill(const Rectangle& rectangle, Colour colour = BLACK) noexcept {
-			std::array<int, 3> rgb = to_rgb(colour);
-			fill(rectangle, rgb[0], rgb[1], rgb[2]);
+		static std::size_t get_bytes() noexcept {
+			return get_pool().bytes;
 		}
 		
+	private:
 		/**
-		 * Fills in the sprite in the area defined by the given shape.
+		 * The pooled surfaces and their statistics.
 		 */
-		void fill(const Shape& shape, int red, int green, int blue) noexcept {
-			for (int i = 0; i < surface->w; i++) {
-				for (int j = 0; j < surface->h; j++) {
-					Rectangle rectangle(i, j, 1, 1);
-					
-					if (shape.contains(rectangle.get_point())) {
-						fill(rectangle, red, green, blue);
+		struct Pool {
+			void clear() noexcept {
+				for (auto& bucket: buckets) {
+					for (SDL_Surface* surface: bucket.second) {
+						SDL_FreeSurface(surface);
 					}
 				}
+				
+				buckets.clear();
+				bytes = 0;
 			}
-		}
+			
+			std::map<std::array<Uint32, 3>, std::vector<SDL_Surface*>> buckets; // The surfaces by size and format.
+			std::size_t bytes = 0;                                              // The bytes of pixels pooled.
+			int hits = 0;                                                       // The surfaces taken from the pool.
+			int misses = 0;                                                     // The surfaces created.
+			SDL_SpinLock lock = 0;                                              // Guards the pool.
+		};
 		
 		/**
-		 * Fills in the sprite in the area defined by the given shape.
-		 * The sprite is filled in with a grayscale shade.
+		 * Returns the number of bytes of pixels in the given surface.
 		 */
-		void fill(const Shape& shape, int brightness) noexcept {
-			fill(shape, brightness, brightness, brightness);
+		static std::size_t size(const SDL_Surface* surface) noexcept {
+			return static_cast<std::size_t>(surface->pitch) * surface->h;
 		}
 		
 		/**
-		 * Fills in the sprite in the area defined by the given shape.
-		 * Uses predefined colours.
+		 * Returns the pool shared by every sprite.
+		 * The pool is never destroyed, so sprites destroyed
+		 *   during static destruction can still use it.
 		 */
-		void fill(const Shape& shape, Colour colour = BLACK) noexcept {
-			std::array<int, 3> rgb = to_rgb(colour);
-			fill(shape, rgb[0], rgb[1], rgb[2]);
+		static Pool& get_pool() noexcept {
+			static Pool* pool = new Pool;
+			
+			return *pool;
 		}
 		
+		static constexpr std::size_t CAPACITY = 32 << 20; // The most bytes of pixels pooled.
+};
+
+/**
+ * A lightweight view of a rectangular area of a sprite.
+ * Views are used to blit part of a sprite, such as a sprite
+ *   packed into an Atlas, as if it were a sprite of its own.
+ * The viewed sprite must outlive the view.
+ */
+class SpriteView {
+	public:
 		/**
-		 * Blits the given sprite to this one.
-		 * The given sprite is scaled to match the size of this one.
+		 * Constructs a view of nothing.
+		 * Blitting an empty view has no effect.
 		 */
-		void blit(const Sprite& sprite) noexcept {
-			SDL_BlitScaled(sprite.surface, nullptr, surface, nullptr);
-		}
+		SpriteView() noexcept {}
 		
 		/**
-		 * Blits the given sprite to this one.
-		 * The top-left corner of the given sprite is blitted to
-		 *   the co-ordinates given.
-		 * No scaling is performed.
+		 * Constructs a view of the given area of the given sprite.
 		 */
-		void blit(const Sprite& sprite, int x, int y) noexcept {
-			SDL_Rect rectangle;
-			rectangle.x = x;
-			rectangle.y = y;
-			SDL_BlitSurface(sprite.surface, nullptr, surface, &rectangle);
-		}
+		SpriteView(const Sprite& s, const Rectangle& a) noexcept:
+			sprite(&s),
+			area(a)
+		{}
 		
 		/**
-		 * Blits the given sprite to this one.
+		 * Constructs a view of the whole of the given sprite.
+		 */
+		explicit SpriteView(const Sprite& s) noexcept;
+		
+		/**
+		 * Returns true if the view is of a sprite.
+		 */
+		explicit operator bool() const noexcept {
+			return sprite;
+		}
+		
+		/**
+		 * Returns the width of the viewed area.
+		 */
+		int width() const noexcept {
+			return area.get_width();
+		}
+		
+		/**
+		 * Returns the height of the viewed area.
+		 */
+		int height() const noexcept {
+			return area.get_height();
+		}
+		
+		/**
+		 * Returns the viewed sprite.
+		 */
+		const Sprite* get_sprite() const noexcept {
+			return sprite;
+		}
+		
+		/**
+		 * Returns the viewed area.
+		 */
+		const Rectangle& get_area() const noexcept {
+			return area;
+		}
+		
+	private:
+		const Sprite* sprite = nullptr; // The viewed sprite.
+		Rectangle area;                 // The viewed area of the sprite.
+};
+
+/**
+ * A wrapper class for SDL_Surfaces.
+ * Manages the blitting of one surface to another.
+ * Also allows for the surface or a rectangular section
+ *   of it to be filled in with a single colour.
+ * Instances of this class are not copiable, but are movable.
+ */
+class Sprite {
+	public:
+		/**
+		 * An enumeration of various predefined colours.
+		 * Used with the sprite filling methods.
+		 */
+		enum Colour {
+			BLACK,   // 000000
+			GREY,    // 7f7f7f
+			WHITE,   // ffffff
+			RED,     // ff0000
+			YELLOW,  // ffff00
+			GREEN,   // 00ff00
+			CYAN,    // 00ffff
+			BLUE,    // 0000ff
+			MAGENTA  // ff00ff
+		};
+		
+		/**
+		 * An enumeration of the pixel formats a sprite can be stored in.
+		 * Used with the sprite converting methods.
+		 * The smaller formats use a colour key for transparency.
+		 */
+		enum Format {
+			TRUE_COLOUR, // 32-bit RGBA
+			HIGH_COLOUR, // 16-bit RGB565
+			INDEXED      // 8-bit palette
+		};
+		
+		/**
+		 * A locked view of a sprite's pixels, for custom per-pixel effects.
+		 * The sprite is locked for the lifetime of the view, so it should not
+		 *   be blitted to or from until the view is destroyed.
+		 * Rows are get_pitch() bytes apart and hold width() pixels
+		 *   in the sprite's own pixel format.
+		 */
+		class PixelView {
+			public:
+				/**
+				 * Locks the given sprite's pixels.
+				 */
+				explicit PixelView(Sprite& sprite) noexcept:
+					surface(sprite.surface)
+				{
+					SDL_LockSurface(surface);
+				}
+				
+				/**
+				 * PixelView objects should not be copied.
+				 * Copying would unlock the sprite twice.
+				 */
+				PixelView(const PixelView&) = delete;
+				
+				/**
+				 * Unlocks the sprite's pixels.
+				 */
+				~PixelView() noexcept {
+					SDL_UnlockSurface(surface);
+				}
+				
+				/**
+				 * PixelView objects should not be copied.
+				 * Copying would unlock the sprite twice.
+				 */
+				PixelView& operator=(const PixelView&) = delete;
+				
+				/**
+				 * Returns the width of the view in pixels.
+				 */
+				int width() const noexcept {
+					return surface->w;
+				}
+				
+				/**
+				 * Returns the height of the view in pixels.
+				 */
+				int height() const noexcept {
+					return surface->h;
+				}
+				
+				/**
+				 * Returns the number of bytes between the starts of two rows.
+				 */
+				int get_pitch() const noexcept {
+					return surface->pitch;
+				}
+				
+				/**
+				 * Returns the number of bytes in each pixel.
+				 */
+				int get_bytes_per_pixel() const noexcept {
+					return surface->format->BytesPerPixel;
+				}
+				
+				/**
+				 * Returns the pixel format of the sprite's surface.
+				 * Used to map colours and find the channels of a pixel.
+				 */
+				const SDL_PixelFormat* get_format() const noexcept {
+					return surface->format;
+				}
+				
+				/**
+				 * Returns the alignment, in bytes, that every row starts at.
+				 * This is the largest power of two, up to 64, that divides
+				 *   both the first row's address and the pitch, so a kernel
+				 *   can check that its vector loads are aligned.
+				 */
+				int get_alignment() const noexcept {
+					std::uintptr_t bits = reinterpret_cast<std::uintptr_t>(surface->pixels)
+						| static_cast<std::uintptr_t>(surface->pitch)
+						| MAX_ALIGNMENT;
+					
+					return static_cast<int>(bits & (~bits + 1));
+				}
+				
+				/**
+				 * Returns the row at the given y position as pixels of the given type.
+				 * The type should match get_bytes_per_pixel(), such as Uint32
+				 *   for true colour and Uint16 for high colour sprites.
+				 */
+				template<typename T>
+				T* row(int y) const noexcept {
+					return reinterpret_cast<T*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch);
+				}
+				
+			private:
+				static constexpr std::uintptr_t MAX_ALIGNMENT = 64; // The greatest alignment reported.
+				
+				SDL_Surface* surface; // The locked surface.
+		};
+		
+		/**
+		 * A 1-bit mask of a sprite's opaque pixels, for exact collision tests.
+		 * Each row is packed into 64-bit words, with the leftmost pixel in
+		 *   the lowest bit, so an overlap test ANDs 64 pixels at a time.
+		 * The mask is a snapshot, so it should be rebuilt if the sprite changes.
+		 */
+		class Mask {
+			public:
+				/**
+				 * Constructs an empty mask, which overlaps nothing.
+				 */
+				Mask() noexcept {}
+				
+				/**
+				 * Constructs the mask of the given sprite.
+				 * Colour keyed pixels, and pixels with less alpha than
+				 *   the given threshold, are transparent.
+				 */
+				explicit Mask(const Sprite& sprite, int threshold = 0x80) noexcept:
+					w(sprite.surface->w),
+					h(sprite.surface->h),
+					words((w + WORD_BITS - 1) / WORD_BITS),
+					bits(words * h)
+				{
+					SDL_Surface* source = sprite.surface;
+					const SDL_PixelFormat* format = source->format;
+					int bytes = format->BytesPerPixel;
+					Uint32 key;
+					bool keyed = !SDL_GetColorKey(source, &key);
+					Uint32 least = (static_cast<Uint32>(threshold) >> format->Aloss) << format->Ashift;
+					
+					SDL_LockSurface(source);
+					
+					for (int y = 0; y < h; y++) {
+						const Uint8* row = static_cast<const Uint8*>(source->pixels) + y * source->pitch;
+						Uint64* out = &bits[y * words];
+						
+						for (int x = 0; x < w; x++) {
+							Uint32 pixel = 0;
+							
+							for (int i = 0; i < bytes; i++) {
+								pixel |= static_cast<Uint32>(row[x * bytes + i]) << (SDL_BYTEORDER == SDL_BIG_ENDIAN ? (bytes - 1 - i) * 8 : i * 8);
+							}
+							
+							bool opaque = !(keyed && pixel == key) && (pixel & format->Amask) >= (least & format->Amask);
+							out[x / WORD_BITS] |= static_cast<Uint64>(opaque) << (x % WORD_BITS);
+						}
+					}
+					
+					SDL_UnlockSurface(source);
+				}
+				
+				/**
+				 * Returns the width of the mask.
+				 */
+				int width() const noexcept {
+					return w;
+				}
+				
+				/**
+				 * Returns the height of the mask.
+				 */
+				int height() const noexcept {
+					return h;
+				}
+				
+				/**
+				 * Returns true if the pixel at the given position is opaque.
+				 */
+				bool get(int x, int y) const noexcept {
+					return x >= 0 && y >= 0 && x < w && y < h && bits[y * words + x / WORD_BITS] >> (x % WORD_BITS) & 1;
+				}
+				
+				/**
+				 * Returns true if an opaque pixel of this mask overlaps one of
+				 *   the given mask, with the given mask's top left corner at
+				 *   the given position relative to this mask's.
+				 * Only the rows and words where the masks overlap are tested,
+				 *   so callers should test the masks' boxes first anyway.
+				 */
+				bool overlaps(const Mask& mask, int x, int y) const noexcept {
+					int top = std::max(y, 0);
+					int bottom = std::min(y + mask.h, h);
+					int left = std::max(x, 0);
+					int right = std::min(x + mask.w, w);
+					
+					if (top >= bottom || left >= right) {
+						return false;
+					}
+					
+					int first = left / WORD_BITS;
+					int last = (right - 1) / WORD_BITS;
+					
+					for (int j = top; j < bottom; j++) {
+						const Uint64* row = &bits[j * words];
+						const Uint64* other = &mask.bits[(j - y) * mask.words];
+						
+						for (int i = first; i <= last; i++) {
+							if (row[i] & mask.shifted(other, i * WORD_BITS - x)) {
+								return true;
+							}
+						}
+					}
+					
+					return false;
+				}
+				
+			private:
+				/**
+				 * Returns the 64 bits of the given row starting at the given bit.
+				 * Bits outside of the row are transparent.
+				 */
+				Uint64 shifted(const Uint64* row, int start) const noexcept {
+					if (start <= -WORD_BITS || start >= words * WORD_BITS) {
+						return 0;
+					}
+					
+					if (start < 0) {
+						return row[0] << -start;
+					}
+					
+					int word = start / WORD_BITS;
+					int offset = start % WORD_BITS;
+					Uint64 low = row[word] >> offset;
+					
+					return offset && word + 1 < words ? low | row[word + 1] << (WORD_BITS - offset) : low;
+				}
+				
+				static constexpr int WORD_BITS = 64; // The number of pixels packed into each word.
+				
+				int w = 0;                // The width of the mask.
+				int h = 0;                // The height of the mask.
+				int words = 0;            // The number of words in each row.
+				std::vector<Uint64> bits; // The rows of opaque pixel bits.
+		};
+		
+		/**
+		 * Constructs a new Sprite object using the given surface.
+		 */
+		Sprite(SDL_Surface* surf) noexcept {
+			surface = surf;
+		}
+		
+		/**
+		 * Constructs a new Sprite object.
+		 * The Sprite is created with the given dimenions.
+		 */
+		Sprite(int width = 0, int height = 0) noexcept {
+			create_surface(width, height);
+		}
+		
+		/**
+		 * Constructs a new Sprite object.
+		 * The Sprite is created with the given dimenions.
+		 * The Sprite is filled in with the given colour.
+		 */
+		Sprite(int width, int height, int red, int green, int blue) noexcept {
+			create_surface(width, height);
+			fill(red, green, blue);
+		}
+		
+		/**
+		 * Constructs a new Sprite object.
+		 * The Sprite is created with the given dimenions.
+		 * The Sprite is filled in with the given greyscale shade.
+		 */
+		Sprite(int width, int height, int brightness) noexcept {
+			create_surface(width, height);
+			fill(brightness, brightness, brightness);
+		}
+		
+		/**
+		 * Constructs a new Sprite object.
+		 * The Sprite is created with the given dimenions.
+		 * The Sprite is filled in with the given colour.
+		 * Uses predefined colours.
+		 */
+		Sprite(int width, int height, Colour colour) noexcept {
+			create_surface(width, height);
+			fill(colour);
+		}
+		
+		/**
+		 * Constructs a new Sprite object.
+		 * The Sprite is loaded from the BMP file passed in
+		 *   string form and is not scaled.
+		 */
+		Sprite(const std::string& source) {
+			surface = SDL_LoadBMP(source.c_str());
+            
+            // An exception is thrown, if the surface couldn't be loaded.
+            if (!surface) {
+                throw std::runtime_error(source + " could not be opened.");
+            }
+            
+			allocated = true;
+		}
+		
+		/**
+		 * Constructs a new Sprite object.
+		 * The Sprite is loaded from the BMP file passed in
+		 *   string form and scaled to the given dimensions.
+		 * Uncompressed 24-bit BMPs are decoded straight to the given
+		 *   dimensions, without loading the full-size image.
+		 */
+		Sprite(const std::string& source, int width, int height) {
+			if (decode_bmp(source, width, height)) {
+				return;
+			}
+			
+			SDL_Surface* raw_surface = SDL_LoadBMP(source.c_str());
+            
+            // An exception is thrown, if the surface couldn't be loaded.
+            if (!raw_surface) {
+                throw std::runtime_error(source + " could not be opened.");
+            }
+            
+			create_surface(width, height);
+			SDL_BlitScaled(raw_surface, nullptr, surface, nullptr);
+			SDL_FreeSurface(raw_surface);
+		}
+		
+        /**
+		 * Constructs a new Sprite object.
+		 * The Sprite is loaded from the BMP file passed in
+		 *   string form and scaled to the given dimensions.
+         * The size of the sprite is a ratio of the given sprite.
+		 */
+        Sprite(
+            const std::string& source,
+            const Sprite& stemplate,
+            double width,
+            double height
+        ):
+            Sprite(
+                source,
+                width * stemplate.width(),
+                height * stemplate.height()
+            )
+        {}
+        
+		/**
+		 * Copying a sprite can be done safely using blitting.
+		 */
+		Sprite(const Sprite& sprite) noexcept {
+			operator=(sprite);
+		}
+		
+		/**
+		 * Sprites can be moved safely.
+		 */
+		Sprite(Sprite&& sprite) noexcept {
+			operator=(std::move(sprite));
+		}
+		
+		/**
+		 * Frees the mmeory dynamically allocated to the surface
+		 *   if it was allocated in this class.
+		 */
+		~Sprite() noexcept {
+			destroy_surface();
+		}
+		
+		/**
+		 * Initialises the sprite with the given surface.
+		 */
+		Sprite& operator=(SDL_Surface* surf) noexcept {
+			destroy_surface();
+			surface = surf;
+			
+			return *this;
+		}
+		
+		/**
+		 * Copying a sprite can be done safely using blitting.
+		 */
+		Sprite& operator=(const Sprite& sprite) noexcept {
+			create_surface(sprite.surface->w, sprite.surface->h);
+			blit(sprite, 0, 0);
+			
+			return *this;
+		}
+		
+		/**
+		 * Sprites can be moved safely.
+		 */
+		Sprite& operator=(Sprite&& sprite) noexcept {
+			destroy_surface();
+			surface = sprite.surface;
+			allocated = sprite.allocated;
+			sprite.allocated = false;
+			
+			return *this;
+		}
+		
+		/**
+		 * Returns the width of the sprite.
+		 */
+		int width() const noexcept {
+			return get_width();
+		}
+		 
+		/**
+		 * Returns the height of the sprite.
+		 */
+		int height() const noexcept {
+			return get_height();
+		}
+		
+		/**
+		 * Returns the width of the sprite.
+		 */
+		int get_width() const noexcept {
+			return surface->w;
+		}
+		
+		/**
+		 * Returns the height of the sprite.
+		 */
+		int get_height() const noexcept {
+			return surface->h;
+		}
+		
+		/**
+		 * Fills in the sprite with the given RGB colour.
+		 */
+		void fill(int red, int green, int blue) noexcept {
+			SDL_FillRect(
+				surface, nullptr,
+				SDL_MapRGB(surface->format, red, green, blue)
+			);
+		}
+		
+		/**
+		 * Fills in the sprite with a grayscale shade.
+		 */
+		void fill(int brightness) noexcept {
+			fill(brightness, brightness, brightness);
+		}
+		
+		/**
+		 * Fills in the sprite with a predefined colour.
+		 */
+		void fill(Colour colour = BLACK) noexcept {
+			std::array<int, 3> rgb = to_rgb(colour);
+			fill(rgb[0], rgb[1], rgb[2]);
+		}
+		
+		/**
+		 * Fills in the sprite in the area defined by the given rectangle.
+		 */
+		void fill(const Rectangle& rectangle, int red, int green, int blue) noexcept {
+			SDL_FillRect(
+				surface, rectangle.get(),
+				SDL_MapRGB(surface->format, red, green, blue)
+			);
+		}
+		
+		/**
+		 * Fills in the sprite in the area defined by the given rectangle.
+		 * The sprite is filled in with a grayscale shade.
+		 */
+		void fill(const Rectangle& rectangle, int brightness) noexcept {
+			fill(rectangle, brightness, brightness, brightness);
+		}
+		
+		/**
+		 * Fills in the sprite in the area defined by the given rectangle.
+		 * Uses predefined colours.
+		 */
+		void fill(const Rectangle& rectangle, Colour colour = BLACK) noexcept {
+			std::array<int, 3> rgb = to_rgb(colour);
+			fill(rectangle, rgb[0], rgb[1], rgb[2]);
+		}
+		
+		/**
+		 * Fills in the sprite in the area defined by the given shape.
+		 */
+		void fill(const Shape& shape, int red, int green, int blue) noexcept {
+			for (int i = 0; i < surface->w; i++) {
+				for (int j = 0; j < surface->h; j++) {
+					Rectangle rectangle(i, j, 1, 1);
+					
+					if (shape.contains(rectangle.get_point())) {
+						fill(rectangle, red, green, blue);
+					}
+				}
+			}
+		}
+		
+		/**
+		 * Fills in the sprite in the area defined by the given shape.
+		 * The sprite is filled in with a grayscale shade.
+		 */
+		void fill(const Shape& shape, int brightness) noexcept {
+			fill(shape, brightness, brightness, brightness);
+		}
+		
+		/**
+		 * Fills in the sprite in the area defined by the given shape.
+		 * Uses predefined colours.
+		 */
+		void fill(const Shape& shape, Colour colour = BLACK) noexcept {
+			std::array<int, 3> rgb = to_rgb(colour);
+			fill(shape, rgb[0], rgb[1], rgb[2]);
+		}
+		
+		/**
+		 * Clears the sprite to be fully transparent.
+		 */
+		void clear() noexcept {
+			SDL_FillRect(surface, nullptr, transparent_pixel());
+		}
+		
+		/**
+		 * Clears the sprite in the area defined by the given
+		 *   rectangle to be fully transparent.
+		 */
+		void clear(const Rectangle& rectangle) noexcept {
+			SDL_FillRect(surface, rectangle.get(), transparent_pixel());
+		}
+		
+		/**
+		 * Restricts blits and fills to the area defined by the given rectangle.
+		 */
+		void set_clip(const Rectangle& rectangle) noexcept {
+			SDL_SetClipRect(surface, rectangle.get());
+		}
+		
+		/**
+		 * Allows blits and fills to the whole sprite.
+		 */
+		void reset_clip() noexcept {
+			SDL_SetClipRect(surface, nullptr);
+		}
+		
+		/**
+		 * Blits the given sprite to this one.
+		 * The given sprite is scaled to match the size of this one.
+		 */
+		void blit(const Sprite& sprite) noexcept {
+			SDL_BlitScaled(sprite.surface, nullptr, surface, nullptr);
+		}
+		
+		/**
+		 * Blits the given sprite to this one.
+		 * The given sprite is scaled to fill the area with its top-left
+		 *   vertex at the given coordinates and the given dimensions.
+		 */
+		void blit(const Sprite& sprite, int x, int y, int width, int height) noexcept {
+			SDL_Rect rectangle;
+			rectangle.x = x;
+			rectangle.y = y;
+			rectangle.w = width;
+			rectangle.h = height;
+			SDL_BlitScaled(sprite.surface, nullptr, surface, &rectangle);
+		}
+		
+		/**
+		 * Blits the given sprite to this one.
+		 * The top-left corner of the given sprite is blitted to
+		 *   the co-ordinates given.
+		 * No scaling is performed.
+		 */
+		void blit(const Sprite& sprite, int x, int y) noexcept {
+			SDL_Rect area = {0, 0, sprite.surface->w, sprite.surface->h};
+			
+			if (!blit_kernel(sprite.surface, area, x, y)) {
+				SDL_Rect rectangle;
+				rectangle.x = x;
+				rectangle.y = y;
+				SDL_BlitSurface(sprite.surface, nullptr, surface, &rectangle);
+			}
+		}
+		
+		/**
+		 * Blits the given sprite to this one.
 		 * The top-left corner of the given sprite is blitted to
 		 *   the coordinates of the given Point.
 		 * No scaling is performed.
 		 */
-		void blit(const Sprite& sprite, const Point& point) noexcept {
-			blit(sprite, point.get_x(), point.get_y());
+		void blit(const Sprite& sprite, const Point& point) noexcept {
+			blit(sprite, point.get_x(), point.get_y());
+		}
+		
+		/**
+		 * Blits the given sprite to this one.
+		 * The top-left corner of the given sprite is blitted to the
+		 *   coordinates of the top-left vertex of the given Rectangle.
+		 * No scaling is performed.
+		 */
+		void blit(const Sprite& sprite, const Rectangle& rectangle) noexcept {
+			blit(sprite, rectangle.get_point());
+		}
+		
+		/**
+		 * Blits the given sprite to this one.
+		 * The centre of the given sprite is blitted in the
+		 *   given position.
+		 * The position is a ratio of the size of this sprite.
+		 * To blit to the centre, one should use 0.5 as x and y.
+		 * No scaling is perfomed.
+		 */
+		void blit(const Sprite& sprite, double x, double y) noexcept {
+			blit(
+				sprite,
+				static_cast<int>(surface->w * x - sprite.surface->w / 2),
+				static_cast<int>(surface->h * y - sprite.surface->h / 2)
+			);
+		}
+		
+		/**
+		 * Blits the viewed area of a sprite to this one.
+		 * The top-left corner of the area is blitted to the co-ordinates given.
+		 * No scaling is performed.
+		 */
+		void blit(const SpriteView& view, int x, int y) noexcept {
+			if (view && !blit_kernel(view.get_sprite()->surface, *view.get_area().get(), x, y)) {
+				SDL_Rect rectangle;
+				rectangle.x = x;
+				rectangle.y = y;
+				SDL_BlitSurface(view.get_sprite()->surface, view.get_area().get(), surface, &rectangle);
+			}
+		}
+		
+		/**
+		 * Blits the viewed area of a sprite to this one.
+		 * The centre of the area is blitted in the given position.
+		 * The position is a ratio of the size of this sprite.
+		 * No scaling is perfomed.
+		 */
+		void blit(const SpriteView& view, double x, double y) noexcept {
+			blit(
+				view,
+				static_cast<int>(surface->w * x - view.width() / 2),
+				static_cast<int>(surface->h * y - view.height() / 2)
+			);
+		}
+		
+		/**
+		 * Copies the given sprite to this one without blending.
+		 * The top-left corner of the given sprite is copied to
+		 *   the co-ordinates given, including its transparency.
+		 */
+		void copy(const Sprite& sprite, int x, int y) noexcept {
+			SDL_BlendMode mode;
+			SDL_GetSurfaceBlendMode(sprite.surface, &mode);
+			SDL_SetSurfaceBlendMode(sprite.surface, SDL_BLENDMODE_NONE);
+			blit(sprite, x, y);
+			SDL_SetSurfaceBlendMode(sprite.surface, mode);
+		}
+		
+		/**
+		 * Adds the given colour to a square of the given size
+		 *   centred at each of the given points.
+		 * The colour added at each point is scaled by its brightness,
+		 *   from 0 to 1, and each channel saturates at its maximum.
+		 * The sprite is locked once for all of the points, so this is
+		 *   much faster than blitting a small sprite to each point.
+		 * Only sprites with 16 or 32 bits per pixel are added to.
+		 * Points are clipped like blits.
+		 */
+		void add_points(
+			const float* x,
+			const float* y,
+			const float* brightness,
+			int count,
+			int size,
+			int red,
+			int green,
+			int blue
+		) noexcept {
+			const SDL_PixelFormat* format = surface->format;
+			int bytes = format->BytesPerPixel;
+			
+			if (bytes != 2 && bytes != 4) {
+				return;
+			}
+			
+			const SDL_Rect& clip = surface->clip_rect;
+			SDL_LockSurface(surface);
+			
+			for (int i = 0; i < count; i++) {
+				int left = static_cast<int>(x[i]) - size / 2;
+				int top = static_cast<int>(y[i]) - size / 2;
+				int right = std::min(left + size, clip.x + clip.w);
+				int bottom = std::min(top + size, clip.y + clip.h);
+				left = std::max(left, clip.x);
+				top = std::max(top, clip.y);
+				
+				Uint32 r = (static_cast<int>(red * brightness[i]) >> format->Rloss) << format->Rshift;
+				Uint32 g = (static_cast<int>(green * brightness[i]) >> format->Gloss) << format->Gshift;
+				Uint32 b = (static_cast<int>(blue * brightness[i]) >> format->Bloss) << format->Bshift;
+				
+				for (int j = top; j < bottom; j++) {
+					Uint8* row = static_cast<Uint8*>(surface->pixels) + j * surface->pitch;
+					
+					for (int k = left; k < right; k++) {
+						if (bytes == 4) {
+							Uint32& pixel = reinterpret_cast<Uint32*>(row)[k];
+							pixel = add_channel(add_channel(add_channel(pixel, r, format->Rmask), g, format->Gmask), b, format->Bmask);
+						}
+						
+						else {
+							Uint16& pixel = reinterpret_cast<Uint16*>(row)[k];
+							pixel = add_channel(add_channel(add_channel(pixel, r, format->Rmask), g, format->Gmask), b, format->Bmask);
+						}
+					}
+				}
+			}
+			
+			SDL_UnlockSurface(surface);
+		}
+		
+		/**
+		 * Makes the pixels of the given RGB colour transparent.
+		 * Keyed pixels are skipped when the sprite is blitted.
+		 */
+		void set_key(int red, int green, int blue) noexcept {
+			SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, red, green, blue));
+		}
+		
+		/**
+		 * Makes the pixels of the predefined colour transparent.
+		 */
+		void set_key(Colour colour) noexcept {
+			std::array<int, 3> rgb = to_rgb(colour);
+			set_key(rgb[0], rgb[1], rgb[2]);
+		}
+		
+		/**
+		 * Run-length encodes the sprite, so that blits skip
+		 *   its transparent pixels in whole runs.
+		 * Pixels with less alpha than the threshold become fully
+		 *   transparent and the rest become fully opaque,
+		 *   so that every run is either skipped or copied.
+		 * Encoding is only worthwhile for sprites that are mostly
+		 *   transparent and are not changed after being encoded,
+		 *   since changing a sprite decodes it.
+		 */
+		void encode_runs(int threshold = 0x80) noexcept {
+			this->threshold(threshold);
+			SDL_SetSurfaceRLE(surface, 1);
+		}
+		
+		/**
+		 * Mixes the sprite's colours towards the given RGB colour by
+		 *   the given amount, from 0 for none to 1 for a flat fill.
+		 * Alpha and colour keyed pixels are left unchanged.
+		 * Only true colour sprites, and displays with 32 bits per pixel, are tinted.
+		 * Like the other effects, this works in place on the locked pixels,
+		 *   with a loop simple enough for the compiler to vectorise.
+		 */
+		void tint(int red, int green, int blue, double amount) noexcept {
+			PixelView view(*this);
+			const SDL_PixelFormat* format = view.get_format();
+			
+			if (view.get_bytes_per_pixel() != 4) {
+				return;
+			}
+			
+			Uint32 colours = format->Rmask | format->Gmask | format->Bmask;
+			Uint32 colour = SDL_MapRGB(format, red, green, blue) & colours;
+			Uint32 weight = to_weight(amount);
+			Uint32 key;
+			bool keyed = !SDL_GetColorKey(surface, &key);
+			int width = view.width();
+			int height = view.height();
+			
+			for (int y = 0; y < height; y++) {
+				Uint32* row = view.row<Uint32>(y);
+				
+				for (int x = 0; x < width; x++) {
+					Uint32 mixed = mix(row[x], colour | (row[x] & ~colours), weight);
+					row[x] = keyed && row[x] == key ? row[x] : mixed;
+				}
+			}
+		}
+		
+		/**
+		 * Mixes the sprite's colours towards the predefined colour.
+		 */
+		void tint(Colour colour, double amount) noexcept {
+			std::array<int, 3> rgb = to_rgb(colour);
+			tint(rgb[0], rgb[1], rgb[2], amount);
+		}
+		
+		/**
+		 * Darkens the sprite towards black by the given amount,
+		 *   from 0 for none to 1 for black.
+		 */
+		void fade(double amount) noexcept {
+			tint(0, 0, 0, amount);
+		}
+		
+		/**
+		 * Mixes the given sprite's pixels into this sprite's by the given
+		 *   amount, from 0 for none to 1 for a copy, where the sprites overlap
+		 *   from their top left corners.
+		 * Unlike a blit, alpha is mixed rather than composited, so this can
+		 *   cross-fade between two frames without a third sprite.
+		 * Colour keyed pixels of this sprite are left unchanged.
+		 * Only sprites that are both in the same 32-bit pixel format are blended.
+		 */
+		void blend(const Sprite& sprite, double amount) noexcept {
+			if (
+				surface->format->BytesPerPixel != 4
+				|| sprite.surface->format->format != surface->format->format
+			) {
+				return;
+			}
+			
+			int width = std::min(surface->w, sprite.surface->w);
+			int height = std::min(surface->h, sprite.surface->h);
+			Uint32 weight = to_weight(amount);
+			Uint32 key;
+			bool keyed = !SDL_GetColorKey(surface, &key);
+			
+			PixelView view(*this);
+			SDL_LockSurface(sprite.surface);
+			
+			for (int y = 0; y < height; y++) {
+				Uint32* row = view.row<Uint32>(y);
+				const Uint32* in = reinterpret_cast<const Uint32*>(
+					static_cast<const Uint8*>(sprite.surface->pixels) + y * sprite.surface->pitch
+				);
+				
+				for (int x = 0; x < width; x++) {
+					Uint32 mixed = mix(row[x], in[x], weight);
+					row[x] = keyed && row[x] == key ? row[x] : mixed;
+				}
+			}
+			
+			SDL_UnlockSurface(sprite.surface);
+		}
+		
+		/**
+		 * Makes pixels with less alpha than the given threshold fully
+		 *   transparent and the rest fully opaque.
+		 * Only sprites with an alpha channel are changed.
+		 */
+		void threshold(int alpha = 0x80) noexcept {
+			PixelView view(*this);
+			const SDL_PixelFormat* format = view.get_format();
+			
+			if (!format->Amask || view.get_bytes_per_pixel() != 4) {
+				return;
+			}
+			
+			Uint32 mask = format->Amask;
+			Uint32 least = (static_cast<Uint32>(alpha) >> format->Aloss) << format->Ashift;
+			int width = view.width();
+			int height = view.height();
+			
+			for (int y = 0; y < height; y++) {
+				Uint32* row = view.row<Uint32>(y);
+				
+				for (int x = 0; x < width; x++) {
+					row[x] = (row[x] & mask) < least ? row[x] & ~mask : row[x] | mask;
+				}
+			}
+		}
+		
+		/**
+		 * Returns the format that the sprite is stored in.
+		 * Formats that are not one of the sprite formats,
+		 *   such as the display's, are treated as true colour.
+		 */
+		Format get_format() const noexcept {
+			switch (surface->format->BitsPerPixel) {
+				case 8:
+					return INDEXED;
+				
+				case 16:
+					return HIGH_COLOUR;
+				
+				default:
+					return TRUE_COLOUR;
+			}
+		}
+		
+		/**
+		 * Converts the sprite to the given format.
+		 * In the smaller formats, pixels that are less than half opaque
+		 *   become transparent and the rest become opaque.
+		 * Magenta is reserved as the transparent colour in high colour.
+		 * Returns false, leaving the sprite unchanged, if an indexed
+		 *   sprite would need more than 256 colours, or if SDL couldn't convert it.
+		 */
+		bool convert(Format format) noexcept {
+			SDL_Surface* converted = nullptr;
+			
+			switch (format) {
+				case TRUE_COLOUR:
+					converted = to_true_colour();
+					break;
+				
+				case HIGH_COLOUR:
+					converted = to_keyed(SDL_PIXELFORMAT_RGB565);
+					break;
+				
+				case INDEXED:
+					return to_indexed();
+			}
+			
+			if (!converted) {
+				return false;
+			}
+			
+			replace_surface(converted);
+			
+			return true;
+		}
+		
+		/**
+		 * Converts the sprite to the pixel format of the given sprite.
+		 * Blits between sprites of the same format are plain copies,
+		 *   so this should be used for sprites blitted every frame.
+		 * If the given sprite's format has no alpha channel,
+		 *   transparency is kept as in the high colour format.
+		 * The sprite is left unchanged if SDL couldn't convert it.
+		 */
+		void convert(const Sprite& sprite) noexcept {
+			SDL_Surface* converted = sprite.surface->format->Amask
+				? SDL_ConvertSurface(surface, sprite.surface->format, 0)
+				: to_keyed(sprite.surface->format->format)
+			;
+			
+			if (converted) {
+				replace_surface(converted);
+			}
+		}
+
+		/**
+		 * Returns the SDL pixel format of the sprite's surface.
+		 */
+		Uint32 get_pixel_format() const noexcept {
+			return surface->format->format;
+		}
+
+		/**
+		 * Copies the sprite's pixels, in its own pixel format, to the given
+		 *   buffer, with each row starting the given number of bytes apart.
+		 * The buffer must hold at least pitch * height() bytes.
+		 */
+		void read_pixels(void* pixels, int pitch) const noexcept {
+			int row = surface->w * surface->format->BytesPerPixel;
+
+			SDL_LockSurface(surface);
+
+			for (int y = 0; y < surface->h; y++) {
+				const Uint8* in = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch;
+				std::copy(in, in + row, static_cast<Uint8*>(pixels) + y * pitch);
+			}
+
+			SDL_UnlockSurface(surface);
+		}
+
+		/**
+		 * Writes the sprite's size, pixel format, colour key,
+		 *   blend mode and packed rows of pixels to the given stream.
+		 * Returns false if the sprite could not be written.
+		 */
+		bool serialise(SDL_RWops* file) const noexcept {
+			Uint32 key;
+			SDL_BlendMode mode;
+			bool keyed = !SDL_GetColorKey(surface, &key);
+			SDL_GetSurfaceBlendMode(surface, &mode);
+			
+			Uint32 header[SERIAL_WORDS] = {
+				static_cast<Uint32>(surface->w),
+				static_cast<Uint32>(surface->h),
+				surface->format->format,
+				keyed,
+				keyed ? key : 0,
+				static_cast<Uint32>(mode)
+			};
+			
+			bool written = SDL_RWwrite(file, header, sizeof(Uint32), SERIAL_WORDS) == SERIAL_WORDS;
+			int row = surface->w * surface->format->BytesPerPixel;
+			
+			SDL_LockSurface(surface);
+			
+			for (int y = 0; written && row && y < surface->h; y++) {
+				written = SDL_RWwrite(file, static_cast<const Uint8*>(surface->pixels) + y * surface->pitch, row, 1) == 1;
+			}
+			
+			SDL_UnlockSurface(surface);
+			
+			return written;
+		}
+		
+		/**
+		 * Replaces the sprite with one read from the given stream,
+		 *   as written by serialise().
+		 * The rows are read straight into the new surface.
+		 * Returns false, and leaves the sprite unchanged,
+		 *   if the stream does not hold a whole sprite.
+		 */
+		bool deserialise(SDL_RWops* file) noexcept {
+			Uint32 header[SERIAL_WORDS];
+			
+			if (
+				SDL_RWread(file, header, sizeof(Uint32), SERIAL_WORDS) != SERIAL_WORDS
+				|| header[0] > SERIAL_MAX_SIZE
+				|| header[1] > SERIAL_MAX_SIZE
+				|| SDL_BYTESPERPIXEL(header[2]) == 0
+				|| SDL_ISPIXELFORMAT_INDEXED(header[2])
+			) {
+				return false;
+			}
+			
+			SDL_Surface* loaded = SurfacePool::create(header[0], header[1], header[2]);
+			
+			if (!loaded) {
+				return false;
+			}
+			
+			int row = loaded->w * loaded->format->BytesPerPixel;
+			bool read = true;
+			
+			for (int y = 0; read && row && y < loaded->h; y++) {
+				read = SDL_RWread(file, static_cast<Uint8*>(loaded->pixels) + y * loaded->pitch, row, 1) == 1;
+			}
+			
+			if (!read) {
+				SurfacePool::recycle(loaded);
+				return false;
+			}
+			
+			if (header[3]) {
+				SDL_SetColorKey(loaded, SDL_TRUE, header[4]);
+			}
+			
+			SDL_SetSurfaceBlendMode(loaded, static_cast<SDL_BlendMode>(header[5]));
+			replace_surface(loaded);
+			
+			return true;
+		}
+
+		/**
+		 * Returns the colour in RGB form.
+		 */
+		static std::array<int, 3> to_rgb(Colour colour) noexcept {
+			std::array<int, 3> rgb;
+			
+			switch (colour) {
+				case BLACK:
+					rgb[0] = 0;
+					rgb[1] = 0;
+					rgb[2] = 0;
+					break;
+				
+				case RED:
+					rgb[0] = 0xff;
+					rgb[1] = 0;
+					rgb[2] = 0;
+					break;
+					
+				case GREEN:
+					rgb[0] = 0;
+					rgb[1] = 0xff;
+					rgb[2] = 0;
+					break;
+					
+				case BLUE:
+					rgb[0] = 0;
+					rgb[1] = 0;
+					rgb[2] = 0xff;
+					break;
+					
+				case YELLOW:
+					rgb[0] = 0xff;
+					rgb[1] = 0xff;
+					rgb[2] = 0;
+					break;
+					
+				case CYAN:
+					rgb[0] = 0;
+					rgb[1] = 0xff;
+					rgb[2] = 0xff;
+					break;
+					
+				case MAGENTA:
+					rgb[0] = 0xff;
+					rgb[1] = 0;
+					rgb[2] = 0xff;
+					break;
+				
+				case WHITE:
+					rgb[0] = 0xff;
+					rgb[1] = 0xff;
+					rgb[2] = 0xff;
+					break;
+					
+				case GREY:
+					rgb[0] = 0x7f;
+					rgb[1] = 0x7f;
+					rgb[2] = 0x7f;
+					break;
+			}
+			
+			return rgb;
+		}
+		
+	protected:
+		/**
+		 * Returns the surface containing the sprite's pixels.
+		 */
+		SDL_Surface* get_surface() const noexcept {
+			return surface;
+		}
+		
+		/**
+		 * Replaces the surface with the given newly allocated one.
+		 */
+		void replace_surface(SDL_Surface* surf) noexcept {
+			destroy_surface();
+			surface = surf;
+			allocated = true;
+		}
+		
+	private:
+		/**
+		 * Takes a new surface with the given dimensions from the surface pool.
+		 * If a surface was already dynamically allocated, it is destroyed.
+		 */
+		void create_surface(int width, int height) noexcept {
+			destroy_surface();
+			
+			surface = SurfacePool::create(
+				width,
+				height,
+				SDL_MasksToPixelFormatEnum(
+					SURFACE_DEPTH,
+					SURFACE_MASKS[SPRITE_BYTE_ORDER][0], SURFACE_MASKS[SPRITE_BYTE_ORDER][1],
+					SURFACE_MASKS[SPRITE_BYTE_ORDER][2], SURFACE_MASKS[SPRITE_BYTE_ORDER][3]
+				)
+			);
+			
+			allocated = true;
+		}
+		
+		/**
+		 * Destroys the surface if it was allocated.
+		 * The surface is returned to the surface pool, if it can be reused.
+		 */
+		void destroy_surface() noexcept {
+			if (allocated) {
+				SurfacePool::recycle(surface);
+				allocated = false;
+			}
+		}
+		
+		/**
+		 * Adds the given value to the channel of the pixel with the given mask.
+		 * The value must already be shifted into the channel.
+		 * The channel saturates at its maximum, without the sum
+		 *   overflowing, even when the channel is the top byte.
+		 */
+		static Uint32 add_channel(Uint32 pixel, Uint32 value, Uint32 mask) noexcept {
+			Uint32 channel = pixel & mask;
+			
+			return (pixel & ~mask) | (value > mask - channel ? mask : channel + value);
+		}
+		
+		/**
+		 * Mixes two 32-bit pixels, byte by byte, by the given weight out of 256.
+		 * The even and odd bytes are each mixed in one multiply, with
+		 *   a byte of headroom between them, so no channel carries into another.
+		 */
+		static Uint32 mix(Uint32 pixel, Uint32 target, Uint32 weight) noexcept {
+			Uint32 inverse = 256 - weight;
+			Uint32 even = ((pixel & 0x00ff00ff) * inverse + (target & 0x00ff00ff) * weight) >> 8;
+			Uint32 odd = ((pixel >> 8) & 0x00ff00ff) * inverse + ((target >> 8) & 0x00ff00ff) * weight;
+			
+			return (even & 0x00ff00ff) | (odd & 0xff00ff00);
+		}
+		
+		/**
+		 * Converts an amount from 0 to 1 to a weight out of 256 for mix().
+		 */
+		static Uint32 to_weight(double amount) noexcept {
+			return static_cast<Uint32>(std::min(std::max(amount, 0.0), 1.0) * 256 + 0.5);
+		}
+		
+		/**
+		 * Reads a little-endian integer of the given number of bytes.
+		 */
+		static Uint32 read_le(const Uint8* data, int offset, int bytes) noexcept {
+			Uint32 value = 0;
+			
+			for (int i = bytes - 1; i >= 0; i--) {
+				value = value << 8 | data[offset + i];
+			}
+			
+			return value;
+		}
+		
+		/**
+		 * Decodes an uncompressed 24-bit BMP into a new surface of the given size.
+		 * Each destination pixel takes the source pixel nearest its centre.
+		 * Only the sampled rows are read, one at a time and in file order,
+		 *   so the full-size image is never held in memory.
+		 * Returns false, with no surface allocated, if the file could not be
+		 *   read or is another kind of BMP.
+		 */
+		bool decode_bmp(const std::string& source, int width, int height) noexcept {
+			SDL_RWops* file = SDL_RWFromFile(source.c_str(), "rb");
+			
+			if (!file) {
+				return false;
+			}
+			
+			Uint8 header[BMP_HEADER_SIZE];
+			bool valid = SDL_RWread(file, header, BMP_HEADER_SIZE, 1) == 1
+				&& header[0] == 'B'
+				&& header[1] == 'M'
+				&& read_le(header, 14, 4) >= BMP_HEADER_SIZE - 14
+				&& read_le(header, 28, 2) == 24
+				&& read_le(header, 30, 4) == 0;
+			Uint32 offset = read_le(header, 10, 4);
+			int source_width = static_cast<Sint32>(read_le(header, 18, 4));
+			int source_height = static_cast<Sint32>(read_le(header, 22, 4));
+			
+			// Negative heights are stored top to bottom.
+			bool bottom_up = source_height > 0;
+			source_height = std::abs(source_height);
+			
+			if (!valid || source_width <= 0 || !source_height || width <= 0 || height <= 0) {
+				SDL_RWclose(file);
+				return false;
+			}
+			
+			create_surface(width, height);
+			
+			// The byte offset of the source pixel sampled for each column.
+			std::vector<int> columns(width);
+			
+			for (int x = 0; x < width; x++) {
+				columns[x] = 3 * ((2 * x + 1) * static_cast<long long>(source_width) / (2 * width));
+			}
+			
+			std::vector<Uint8> row(3 * source_width);
+			int pitch = (3 * source_width + 3) & ~3;
+			int last = -1;
+			bool read = true;
+			SDL_LockSurface(surface);
+			
+			for (int i = 0; i < height && read; i++) {
+				int y = bottom_up ? height - 1 - i : i;
+				int line = (2 * y + 1) * static_cast<long long>(source_height) / (2 * height);
+				line = bottom_up ? source_height - 1 - line : line;
+				Uint32* out = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch);
+				
+				// Rows that sample the same line as the last row copy it.
+				if (line == last) {
+					const Uint8* previous = static_cast<Uint8*>(surface->pixels) + (bottom_up ? y + 1 : y - 1) * surface->pitch;
+					std::copy(previous, previous + width * sizeof(Uint32), reinterpret_cast<Uint8*>(out));
+					continue;
+				}
+				
+				read = SDL_RWseek(file, offset + static_cast<Sint64>(line) * pitch, RW_SEEK_SET) >= 0
+					&& SDL_RWread(file, row.data(), row.size(), 1) == 1;
+				last = line;
+				
+				if (width == source_width) {
+					widen(row.data(), out, width);
+				}
+				
+				else {
+					sample(row.data(), out, columns);
+				}
+			}
+			
+			SDL_UnlockSurface(surface);
+			SDL_RWclose(file);
+			
+			// A truncated file leaves the sprite unloaded.
+			if (!read) {
+				destroy_surface();
+				surface = nullptr;
+			}
+			
+			return read;
+		}
+		
+		/**
+		 * Converts a row of BGR pixels to the sprite's 32-bit format.
+		 * The loop has no branches or lookups, so it can be vectorised.
+		 */
+		void widen(const Uint8* in, Uint32* out, int width) const noexcept {
+			const SDL_PixelFormat* format = surface->format;
+			int red = format->Rshift;
+			int green = format->Gshift;
+			int blue = format->Bshift;
+			Uint32 alpha = format->Amask;
+			
+			for (int x = 0; x < width; x++) {
+				out[x] = static_cast<Uint32>(in[3 * x + 2]) << red
+					| static_cast<Uint32>(in[3 * x + 1]) << green
+					| static_cast<Uint32>(in[3 * x]) << blue
+					| alpha;
+			}
+		}
+		
+		/**
+		 * Converts the BGR pixels at the given byte offsets
+		 *   to a row of the sprite's 32-bit format.
+		 */
+		void sample(const Uint8* in, Uint32* out, const std::vector<int>& columns) const noexcept {
+			const SDL_PixelFormat* format = surface->format;
+			int red = format->Rshift;
+			int green = format->Gshift;
+			int blue = format->Bshift;
+			Uint32 alpha = format->Amask;
+			
+			for (std::size_t x = 0; x < columns.size(); x++) {
+				const Uint8* pixel = in + columns[x];
+				out[x] = static_cast<Uint32>(pixel[2]) << red
+					| static_cast<Uint32>(pixel[1]) << green
+					| static_cast<Uint32>(pixel[0]) << blue
+					| alpha;
+			}
+		}
+		
+		/**
+		 * Blits the given area of the given surface to this sprite, unscaled,
+		 *   with the top-left corner of the area at the given coordinates.
+		 * The blit is done by a kernel specialised for the surfaces'
+		 *   formats, the source's blend mode and the blit's width.
+		 * Returns false, without blitting, if no kernel applies, such as to
+		 *   run-length encoded or modulated surfaces, so that SDL blits it instead.
+		 */
+		bool blit_kernel(SDL_Surface* source, SDL_Rect area, int x, int y) noexcept {
+			Uint32 key = 0;
+			Uint8 alpha;
+			Uint8 colour[3];
+			SDL_BlendMode blend;
+			bool keyed = !SDL_GetColorKey(source, &key);
+			SDL_GetSurfaceAlphaMod(source, &alpha);
+			SDL_GetSurfaceColorMod(source, &colour[0], &colour[1], &colour[2]);
+			SDL_GetSurfaceBlendMode(source, &blend);
+			bool blended = source->format->Amask && blend == SDL_BLENDMODE_BLEND;
+			
+			if (
+				source == surface
+				|| SDL_MUSTLOCK(source)
+				|| SDL_MUSTLOCK(surface)
+				|| alpha != 0xff
+				|| colour[0] != 0xff
+				|| colour[1] != 0xff
+				|| colour[2] != 0xff
+				|| (blend != SDL_BLENDMODE_NONE && blend != SDL_BLENDMODE_BLEND)
+				|| (keyed && blended)
+			) {
+				return false;
+			}
+			
+			// The area is clipped to the source, and the destination is moved with it.
+			int left = std::max(area.x, 0);
+			int top = std::max(area.y, 0);
+			x += left - area.x;
+			y += top - area.y;
+			area.w = std::min(area.x + area.w, source->w) - left;
+			area.h = std::min(area.y + area.h, source->h) - top;
+			area.x = left;
+			area.y = top;
+			
+			// The destination is clipped to this sprite's clip rectangle.
+			const SDL_Rect& clip = surface->clip_rect;
+			int right = std::min(x + area.w, clip.x + clip.w);
+			int bottom = std::min(y + area.h, clip.y + clip.h);
+			left = std::max(x, clip.x);
+			top = std::max(y, clip.y);
+			
+			if (right <= left || bottom <= top) {
+				return true;
+			}
+			
+			Blitter::Kernel kernel = Blitter::find(
+				source->format->format,
+				surface->format->format,
+				keyed ? Blitter::KEY : blended ? Blitter::BLEND : Blitter::COPY,
+				right - left
+			);
+			
+			if (!kernel) {
+				return false;
+			}
+			
+			kernel(
+				static_cast<const Uint8*>(source->pixels)
+					+ (area.y + top - y) * source->pitch
+					+ (area.x + left - x) * source->format->BytesPerPixel,
+				source->pitch,
+				static_cast<Uint8*>(surface->pixels)
+					+ top * surface->pitch
+					+ left * surface->format->BytesPerPixel,
+				surface->pitch,
+				right - left,
+				bottom - top,
+				key
+			);
+			
+			return true;
+		}
+		
+		/**
+		 * Returns the value of a transparent pixel.
+		 * This is the colour key, if the surface has one.
+		 */
+		Uint32 transparent_pixel() const noexcept {
+			Uint32 key;
+			
+			return SDL_GetColorKey(surface, &key) ? 0 : key;
+		}
+		
+		/**
+		 * Returns a new true colour copy of the surface.
+		 * Colour keyed pixels become transparent.
+		 */
+		SDL_Surface* to_true_colour() const noexcept {
+			return SDL_ConvertSurfaceFormat(
+				surface,
+				SDL_MasksToPixelFormatEnum(
+					SURFACE_DEPTH,
+					SURFACE_MASKS[SPRITE_BYTE_ORDER][0], SURFACE_MASKS[SPRITE_BYTE_ORDER][1],
+					SURFACE_MASKS[SPRITE_BYTE_ORDER][2], SURFACE_MASKS[SPRITE_BYTE_ORDER][3]
+				),
+				0
+			);
+		}
+		
+		/**
+		 * Returns a new copy of the surface in the given pixel format,
+		 *   or nullptr if it couldn't be converted.
+		 * Transparent pixels are keyed with magenta.
+		 */
+		SDL_Surface* to_keyed(Uint32 format) const noexcept {
+			SDL_Surface* source = to_true_colour();
+			bool transparent = false;
+			
+			if (!source) {
+				return nullptr;
+			}
+			
+			SDL_LockSurface(source);
+			
+			for (int y = 0; y < source->h; y++) {
+				Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(source->pixels) + y * source->pitch);
+				
+				for (int x = 0; x < source->w; x++) {
+					if ((row[x] & source->format->Amask) < (source->format->Amask & ALPHA_THRESHOLD)) {
+						row[x] = SDL_MapRGBA(source->format, 0xff, 0, 0xff, 0xff);
+						transparent = true;
+					}
+					
+					else {
+						row[x] |= source->format->Amask;
+					}
+				}
+			}
+			
+			SDL_UnlockSurface(source);
+			
+			SDL_Surface* keyed = SDL_ConvertSurfaceFormat(source, format, 0);
+			SDL_FreeSurface(source);
+			
+			if (keyed && transparent) {
+				SDL_SetColorKey(keyed, SDL_TRUE, SDL_MapRGB(keyed->format, 0xff, 0, 0xff));
+			}
+			
+			return keyed;
+		}
+		
+		/**
+		 * Replaces the surface with an indexed copy, if it has few enough colours.
+		 * Returns true if the surface was replaced.
+		 * The first palette entry is the colour key, if any pixels are transparent.
+		 */
+		bool to_indexed() noexcept {
+			SDL_Surface* source = to_true_colour();
+			
+			if (!source) {
+				return false;
+			}
+			
+			Uint32 alpha = source->format->Amask;
+			std::vector<Uint32> colours;
+			
+			SDL_LockSurface(source);
+			
+			// The pixels are made fully opaque or fully transparent.
+			for (int y = 0; y < source->h; y++) {
+				Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(source->pixels) + y * source->pitch);
+				
+				for (int x = 0; x < source->w; x++) {
+					row[x] = (row[x] & alpha) < (alpha & ALPHA_THRESHOLD) ? 0 : row[x] | alpha;
+					colours.push_back(row[x]);
+				}
+			}
+			
+			std::sort(colours.begin(), colours.end());
+			colours.erase(std::unique(colours.begin(), colours.end()), colours.end());
+			
+			if (colours.size() > PALETTE_SIZE) {
+				SDL_UnlockSurface(source);
+				SDL_FreeSurface(source);
+				
+				return false;
+			}
+			
+			// Transparent black sorts first, so it takes the first entry.
+			bool transparent = !colours.empty() && !colours[0];
+			std::vector<SDL_Color> palette(colours.size());
+			
+			for (std::size_t i = 0; i < colours.size(); i++) {
+				SDL_GetRGBA(colours[i], source->format, &palette[i].r, &palette[i].g, &palette[i].b, &palette[i].a);
+			}
+			
+			SDL_Surface* indexed = SDL_CreateRGBSurfaceWithFormat(0, source->w, source->h, 8, SDL_PIXELFORMAT_INDEX8);
+			
+			if (!indexed) {
+				SDL_UnlockSurface(source);
+				SDL_FreeSurface(source);
+				
+				return false;
+			}
+			
+			SDL_SetPaletteColors(indexed->format->palette, palette.data(), 0, palette.size());
+			
+			for (int y = 0; y < source->h; y++) {
+				const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<Uint8*>(source->pixels) + y * source->pitch);
+				Uint8* destination = static_cast<Uint8*>(indexed->pixels) + y * indexed->pitch;
+				
+				for (int x = 0; x < source->w; x++) {
+					destination[x] = std::lower_bound(colours.begin(), colours.end(), row[x]) - colours.begin();
+				}
+			}
+			
+			SDL_UnlockSurface(source);
+			SDL_FreeSurface(source);
+			
+			if (transparent) {
+				SDL_SetColorKey(indexed, SDL_TRUE, 0);
+			}
+			
+			replace_surface(indexed);
+			
+			return true;
+		}
+		
+		static constexpr int SPRITE_BYTE_ORDER          // Byte ordering of the surface pixels.
+			= SDL_BYTEORDER != SDL_BIG_ENDIAN; 
+		static constexpr int SURFACE_DEPTH = 32;        // The number of bits per pixel.
+		static constexpr Uint32 ALPHA_THRESHOLD         // The least alpha of an opaque keyed pixel,
+			= 0x80808080;                               //   repeated to fit any alpha mask.
+		static constexpr int PALETTE_SIZE = 256;        // The number of colours in an indexed palette.
+		static constexpr int BMP_HEADER_SIZE = 54;      // The size of a BMP's file and info headers.
+		static constexpr int SERIAL_WORDS = 6;          // The number of words in a serialised sprite's header.
+		static constexpr Uint32 SERIAL_MAX_SIZE         // The largest serialised width or height.
+			= 1 << 14;
+		static constexpr Uint32 SURFACE_MASKS[2][4] = { // The position of bits for RGBA.
+			{
+				0xff000000,
+				0x00ff0000,
+				0x0000ff00,
+				0x000000ff
+			},
+			{
+				0x000000ff,
+				0x0000ff00,
+				0x00ff0000,
+				0xff000000
+			}
+		};
+		
+		SDL_Surface* surface;   // The surface containing the pixel data of the sprite.
+		bool allocated = false; // True if the surface's memory was allocated in this class.
+};
+
+/**
+ * Constructs a view of the whole of the given sprite.
+ */
+SpriteView::SpriteView(const Sprite& s) noexcept:
+	sprite(&s),
+	area(0, 0, s.get_width(), s.get_height())
+{}
+
+/**
+ * A class that packs sprites into a few large sprites, called pages.
+ * Sprites are added and then packed together, after which each
+ *   one is blitted from its page through a SpriteView.
+ * Keeping sprites that are blitted together in the same page means
+ *   that the blitter reads from fewer, contiguous areas of memory.
+ * Sprites are packed into shelves, from the tallest to the shortest.
+ * A sprite that is larger than a page is given a page of its own.
+ */
+class Atlas {
+	public:
+		/**
+		 * Constructs an empty atlas with pages of at most the given dimensions.
+		 * The pages are stored in the given format.
+		 * Pages with too many colours to be indexed are stored in high colour.
+		 * The pages are run-length encoded, so transparent areas are not blitted,
+		 *   unless encoding is turned off, so that they are blitted by the
+		 *   kernels specialised for their format instead.
+		 */
+		Atlas(
+			int width,
+			int height,
+			Sprite::Format format = Sprite::TRUE_COLOUR,
+			bool encoded = true
+		) noexcept:
+			page_width(width),
+			page_height(height),
+			format(format),
+			encoded(encoded)
+		{}
+		
+		/**
+		 * Adds the sprite to be packed by the next call to pack().
+		 * Returns the index of the sprite's view.
+		 */
+		int add(Sprite&& sprite) noexcept {
+			pending.push_back(std::move(sprite));
+			views.emplace_back();
+			
+			return views.size() - 1;
+		}
+		
+		/**
+		 * Packs the sprites added since the last call into new pages.
+		 * The added sprites are freed and their views are set.
+		 * Pages are only as large as the sprites packed into them.
+		 */
+		void pack() noexcept {
+			int count = pending.size();
+			int first = views.size() - count;
+			
+			// The sprites are packed from the tallest to the shortest.
+			std::vector<int> order(count);
+			
+			for (int i = 0; i < count; i++) {
+				order[i] = i;
+			}
+			
+			std::stable_sort(
+				order.begin(),
+				order.end(),
+				[this](int a, int b) {
+					return pending[a].get_height() > pending[b].get_height();
+				}
+			);
+			
+			// The position and page of each sprite is found.
+			std::vector<Rectangle> areas(count);
+			std::vector<int> page_indices(count);
+			std::vector<std::array<int, 2>> extents;
+			int x = 0;
+			int y = 0;
+			int shelf = 0;
+			
+			for (int i: order) {
+				int width = pending[i].get_width();
+				int height = pending[i].get_height();
+				
+				// The sprite starts a new shelf if the current one is full.
+				if (!extents.empty() && x + width > page_width) {
+					x = 0;
+					y += shelf;
+					shelf = 0;
+				}
+				
+				// The sprite starts a new page if the current one is full.
+				if (extents.empty() || y + height > page_height) {
+					extents.push_back({0, 0});
+					x = 0;
+					y = 0;
+					shelf = 0;
+				}
+				
+				std::array<int, 2>& extent = extents.back();
+				areas[i].set(x, y, width, height);
+				page_indices[i] = pages.size() + extents.size() - 1;
+				extent[0] = std::max(extent[0], x + width);
+				extent[1] = std::max(extent[1], y + height);
+				shelf = std::max(shelf, height);
+				x += width;
+			}
+			
+			// The pages are created.
+			std::size_t first_page = pages.size();
+			
+			for (const std::array<int, 2>& extent: extents) {
+				pages.push_back(std::make_unique<Sprite>(extent[0], extent[1]));
+				pages.back()->clear();
+			}
+			
+			// The sprites are copied to their pages.
+			for (int i = 0; i < count; i++) {
+				Sprite& page = *pages[page_indices[i]];
+				page.copy(pending[i], areas[i].get_x(), areas[i].get_y());
+				views[first + i] = SpriteView(page, areas[i]);
+			}
+			
+			// The pages are converted and encoded once they are filled in.
+			for (std::size_t i = first_page; i < pages.size(); i++) {
+				if (!pages[i]->convert(format)) {
+					pages[i]->convert(Sprite::HIGH_COLOUR);
+				}
+				
+				if (encoded) {
+					pages[i]->encode_runs();
+				}
+			}
+			
+			pending.clear();
+		}
+		
+		/**
+		 * Returns the view of the sprite with the given index.
+		 * The view is empty until the sprite has been packed.
+		 */
+		const SpriteView& get(int index) const noexcept {
+			return views[index];
+		}
+		
+		/**
+		 * Returns the number of pages.
+		 */
+		int get_pages() const noexcept {
+			return pages.size();
+		}
+		
+	private:
+		std::vector<Sprite> pending;                // The sprites waiting to be packed.
+		std::vector<std::unique_ptr<Sprite>> pages; // The sprites that the sprites are packed into.
+		std::vector<SpriteView> views;              // The views of the packed sprites.
+		int page_width;                             // The maximum width of a page.
+		int page_height;                            // The maximum height of a page.
+		Sprite::Format format;                      // The format the pages are stored in.
+		bool encoded;                               // True if the pages are run-length encoded.
+};
+
+/**
+ * A class that keeps sprites sized as ratios of a base sprite, such as
+ *   the display, and rescales them when the base is resized.
+ * The full-size source of each sprite is kept, so rescaling never reloads
+ *   a file and never compounds the blur of an earlier rescale.
+ * Only the sprites whose size in pixels changes are rescaled.
+ * They are rescaled on worker threads while the old sprites are still
+ *   used, and are swapped in together by update(), so anything built from
+ *   them, such as an atlas, is rebuilt once per resize.
+ * Instances of this class are neither copiable nor movable.
+ */
+class Layout {
+	public:
+		/**
+		 * Constructs an empty layout for the given base sprite's size.
+		 */
+		Layout(const Sprite& base) noexcept:
+			width(base.width()),
+			height(base.height())
+		{}
+		
+		/**
+		 * Layout objects should not be copied.
+		 * The worker threads refer to the layout that started them.
+		 */
+		Layout(const Layout&) = delete;
+		
+		/**
+		 * Waits for the worker threads to return.
+		 */
+		~Layout() noexcept {
+			finish();
+		}
+		
+		/**
+		 * Layout objects should not be copied.
+		 * The worker threads refer to the layout that started them.
+		 */
+		Layout& operator=(const Layout&) = delete;
+		
+		/**
+		 * Adds the given full-size source, scaled to the given ratios
+		 *   of the base's width and height.
+		 * Returns the index of the scaled sprite.
+		 */
+		int add(Sprite&& source, double w, double h) noexcept {
+			return add(std::move(source), w, h, false, Sprite::BLACK);
+		}
+		
+		/**
+		 * Adds the given full-size source, scaled to the given ratios
+		 *   of the base's width and height and keyed with the given colour.
+		 * Returns the index of the scaled sprite.
+		 */
+		int add(Sprite&& source, double w, double h, Sprite::Colour key) noexcept {
+			return add(std::move(source), w, h, true, key);
+		}
+		
+		/**
+		 * Returns the scaled sprite with the given index.
+		 * Until update() swaps in the rescaled sprites,
+		 *   this is the sprite for the previous size.
+		 */
+		const Sprite& get(int index) const noexcept {
+			return entries[index].sprite;
+		}
+		
+		/**
+		 * Starts rescaling the sprites whose size changes with the base's new size.
+		 * If sprites are already being rescaled, the new size is
+		 *   rescaled for once they have been swapped in.
+		 */
+		void resize(const Sprite& base) noexcept {
+			width = base.width();
+			height = base.height();
+			
+			if (!rescaling) {
+				start();
+			}
+		}
+		
+		/**
+		 * Swaps in the rescaled sprites, if all of them are done.
+		 * Returns true if sprites were swapped in, in which case
+		 *   references to the old sprites are no longer valid.
+		 * Should be called once per frame.
+		 */
+		bool update() noexcept {
+			if (!rescaling || SDL_AtomicGet(&done) < static_cast<int>(jobs.size())) {
+				return false;
+			}
+			
+			finish();
+			
+			for (const Job& job: jobs) {
+				entries[job.index].sprite = std::move(entries[job.index].rescaled);
+			}
+			
+			// The base may have been resized again while rescaling.
+			start();
+			
+			return true;
+		}
+		
+		/**
+		 * Returns true if sprites are being rescaled.
+		 */
+		bool is_rescaling() const noexcept {
+			return rescaling;
+		}
+		
+	private:
+		/**
+		 * A sprite in the layout, with its source and its size as ratios of the base.
+		 */
+		struct Entry {
+			Sprite source;       // The full-size source.
+			double width;        // The ratio of the base's width.
+			double height;       // The ratio of the base's height.
+			bool keyed;          // True if the sprite is colour keyed.
+			Sprite::Colour key;  // The colour key.
+			Sprite sprite;       // The sprite at the current size.
+			Sprite rescaled;     // The sprite at the next size.
+		};
+		
+		/**
+		 * A sprite to be rescaled, with its new size.
+		 */
+		struct Job {
+			int index;
+			int width;
+			int height;
+		};
+		
+		/**
+		 * Adds an entry and scales its sprite for the current size.
+		 */
+		int add(Sprite&& source, double w, double h, bool keyed, Sprite::Colour key) noexcept {
+			// The entries can't be moved while the workers use them.
+			finish();
+			
+			entries.emplace_back();
+			Entry& entry = entries.back();
+			entry.source = std::move(source);
+			entry.width = w;
+			entry.height = h;
+			entry.keyed = keyed;
+			entry.key = key;
+			entry.sprite = scale(entry, w * width, h * height);
+			
+			return entries.size() - 1;
+		}
+		
+		/**
+		 * Returns the entry's source scaled to the given size.
+		 */
+		static Sprite scale(const Entry& entry, int w, int h) noexcept {
+			Sprite sprite(w, h);
+			sprite.blit(entry.source, 0, 0, w, h);
+			
+			if (entry.keyed) {
+				sprite.set_key(entry.key);
+			}
+			
+			return sprite;
+		}
+		
+		/**
+		 * Starts the workers on the entries whose size differs from the base's.
+		 */
+		void start() noexcept {
+			jobs.clear();
+			rescaling = false;
+			
+			for (int i = 0; i < static_cast<int>(entries.size()); i++) {
+				const Entry& entry = entries[i];
+				int w = entry.width * width;
+				int h = entry.height * height;
+				
+				if (w != entry.sprite.width() || h != entry.sprite.height()) {
+					jobs.push_back({i, w, h});
+				}
+			}
+			
+			if (jobs.empty()) {
+				return;
+			}
+			
+			SDL_AtomicSet(&next, 0);
+			SDL_AtomicSet(&done, 0);
+			int count = std::min(std::min(SDL_GetCPUCount(), static_cast<int>(MAX_WORKERS)), static_cast<int>(jobs.size()));
+			
+			for (int i = 0; i < count; i++) {
+				workers.push_back(SDL_CreateThread(rescale_entries, "layout", this));
+			}
+			
+			rescaling = true;
+		}
+		
+		/**
+		 * Waits for the workers to return.
+		 */
+		void finish() noexcept {
+			for (SDL_Thread* worker: workers) {
+				SDL_WaitThread(worker, nullptr);
+			}
+			
+			workers.clear();
+		}
+		
+		/**
+		 * Rescales the next unclaimed entry until none are left.
+		 * Each entry is only used by the worker that claims it.
+		 */
+		static int rescale_entries(void* data) noexcept {
+			Layout& layout = *static_cast<Layout*>(data);
+			int count = layout.jobs.size();
+			
+			for (int i = SDL_AtomicAdd(&layout.next, 1); i < count; i = SDL_AtomicAdd(&layout.next, 1)) {
+				const Job& job = layout.jobs[i];
+				Entry& entry = layout.entries[job.index];
+				entry.rescaled = scale(entry, job.width, job.height);
+				SDL_AtomicAdd(&layout.done, 1);
+			}
+			
+			return 0;
+		}
+		
+		static constexpr int MAX_WORKERS = 4; // The most worker threads used for a resize.
+		
+		std::vector<Entry> entries;       // The sprites and their sources.
+		std::vector<Job> jobs;            // The entries being rescaled.
+		std::vector<SDL_Thread*> workers; // The threads rescaling the entries.
+		SDL_atomic_t next = {};           // The index of the next unclaimed job.
+		SDL_atomic_t done = {};           // The number of finished jobs.
+		bool rescaling = false;           // True while the workers have jobs.
+		int width;                        // The base's width.
+		int height;                       // The base's height.
+};
+
+/**
+ * A class that manages the video system.
+ * Each instance of this class corresponds with a window.
+ * Instances of this class are not copiable, but are movable.
+ */
+class Display: public Sprite {
+	public:
+		/**
+		 * An enumeration of the ways that frames can be presented.
+		 * Used with Display::set_backend().
+		 * Sprites are blitted to the display in the same way for each.
+		 */
+		enum Backend {
+			WINDOW_SURFACE,      // Copied to the window's surface by the CPU.
+			SOFTWARE_RENDERER,   // Streamed to a texture of SDL's software renderer.
+			ACCELERATED_RENDERER // Streamed to a texture of a hardware renderer.
+		};
+		
+		/**
+		 * Makes a window with the given dimensions and no title.
+		 * Passing 0 as both the width and height makes
+		 *   a "windowed fullscreen"-style window.
+		 */
+		Display(int width = 0, int height = 0) noexcept:
+			Sprite(nullptr)
+		{
+			if (!width && !height) {
+				SDL_DisplayMode display_mode;
+				SDL_GetDesktopDisplayMode(0, &display_mode);
+				width = display_mode.w;
+				height = display_mode.h;
+			}
+			
+			create_window("", width, height, 0);
+		}
+		
+		/**
+		 * Makes a window with the given title and dimensions.
+		 * Passing 0 as both the width and height makes
+		 *   a "windowed fullscreen"-style window.
+		 */
+		Display(const std::string& title, int width = 0, int height = 0) noexcept:
+			Sprite(nullptr)
+		{
+			if (!width && !height) {
+				SDL_DisplayMode display_mode;
+				SDL_GetDesktopDisplayMode(0, &display_mode);
+				width = display_mode.w;
+				height = display_mode.h;
+			}
+			
+			create_window(title, width, height, 0);
+		}
+		
+		/**
+		 * Makes a window with its dimensions being a ratio of the window size.
+		 * The window is titleless.
+		 */
+		Display(double width, double height) noexcept:
+			Sprite(nullptr)
+		{
+			SDL_DisplayMode display_mode;
+			SDL_GetDesktopDisplayMode(0, &display_mode);
+			
+			create_window(
+				"",
+				width * display_mode.w,
+				height * display_mode.h,
+				0
+			);
+		}
+		
+		/**
+		 * Makes a window with its dimensions being a ratio of the window size.
+		 * The window has a title.
+		 */
+		Display(const std::string& title, double width, double height) noexcept:
+			Sprite(nullptr)
+		{
+			SDL_DisplayMode display_mode;
+			SDL_GetDesktopDisplayMode(0, &display_mode);
+			
+			create_window(
+				title,
+				width * display_mode.w,
+				height * display_mode.h,
+				0
+			);
+		}
+		
+		/**
+		 * Constructs a new Display object from the given window.
+		 * The window is not destroyed when this object is destroyed
+		 *   and is the responsibility of the window's creator.
+		 * For this reason, this constructor is not recommended.
+		 */
+		Display(SDL_Window* win) noexcept:
+			Sprite(nullptr)
+		{
+			window = win;
+			Sprite::operator=(SDL_GetWindowSurface(window));
+			SDL_GetWindowSize(window, &window_width, &window_height);
+		}
+		
+		/**
+		 * Display objects should not be copied.
+		 * Copying can cause the window to be destroyed prematurely or twice.
+		 */
+		Display(const Display&) = delete;
+		
+		/**
+		 * Display objects can be moved safely.
+		 */
+		Display(Display&& display) noexcept:
+			Sprite(nullptr)
+		{
+			operator=(std::move(display));
+		}
+		
+		/**
+		 * Destroys the window associated with the object if
+		 *   the memory for it was allocated by this object.
+		 * Frees the memory allocated to the Sprite object.
+		 */
+		~Display() noexcept {
+			set_asynchronous(false);
+			destroy_renderer();
+			destroy_window();
+		}
+		
+		/**
+		 * Display objects should not be copied.
+		 * Copying can cause the window to be destroyed prematurely or twice.
+		 */
+		Display& operator=(const Display&) = delete;
+		
+		/**
+		 * Display objects can be moved safely.
+		 */
+		Display& operator=(Display&& display) noexcept {
+			// The present threads refer to their displays, so they are restarted.
+			bool async = display.asynchronous;
+			set_asynchronous(false);
+			display.set_asynchronous(false);
+			
+			destroy_renderer();
+			destroy_window();
+			window = display.window;
+			Sprite::operator=(std::move(static_cast<Sprite&&>(display)));
+			window_allocated = display.window_allocated;
+			display.window_allocated = false;
+			scale = display.scale;
+			window_width = display.window_width;
+			window_height = display.window_height;
+			backend = display.backend;
+			renderer = display.renderer;
+			texture = display.texture;
+			display.backend = WINDOW_SURFACE;
+			display.renderer = nullptr;
+			display.texture = nullptr;
+			last_update = display.last_update;
+			frame_time = display.frame_time;
+			present_time = display.present_time;
+			set_asynchronous(async);
+			
+			return *this;
+		}
+		
+		/**
+		 * Initialises the display with the given window.
+		 * The window is not destroyed when this object is destroyed
+		 *   and is the responsibility of the window's creator.
+		 * For this reason, this use of this method is not recommended.
+		 */
+		Display& operator=(SDL_Window* win) noexcept {
+			destroy_window();
+			window = win;
+			Sprite::operator=(SDL_GetWindowSurface(window));
+			SDL_GetWindowSize(window, &window_width, &window_height);
+			
+			return *this;
+		}
+		
+		/**
+		 * Updates the window's surface.
+		 * If the display is scaled, it is upscaled to the window first.
+		 * If the display is asynchronous, the frame is handed to the
+		 *   present thread and the display switches to its other buffer.
+		 */
+		void update() noexcept {
+			Uint64 start = SDL_GetPerformanceCounter();
+			
+			if (asynchronous) {
+				// The previous frame must be presented before its buffer is drawn to.
+				SDL_SemWait(presented);
+				presenting = drawing;
+				drawing = 1 - drawing;
+				Sprite::operator=(buffers[drawing]);
+				SDL_SemPost(queued);
+			}
+			
+			else {
+				present(get_surface(), renderer ? nullptr : SDL_GetWindowSurface(window));
+			}
+			
+			// The times are measured for the hints.
+			Uint64 end = SDL_GetPerformanceCounter();
+			double frequency = SDL_GetPerformanceFrequency();
+			present_time = (end - start) / frequency;
+			frame_time = last_update ? (end - last_update) / frequency : 0;
+			last_update = end;
+		}
+		
+		/**
+		 * Copies the last frame updated back into the display, so it can be drawn over.
+		 * An asynchronous display's buffer holds the frame before it,
+		 *   so this waits for the last frame to be presented and copies it.
+		 * Other displays still hold the last frame, so nothing is copied.
+		 */
+		void restore() noexcept {
+			if (asynchronous) {
+				finish();
+				SDL_BlitSurface(buffers[presenting], nullptr, buffers[drawing], nullptr);
+			}
+		}
+		
+		/**
+		 * Returns the real time (in seconds) between the last two updates.
+		 * Returns 0 until the display has been updated twice.
+		 * This is a hint for adjusting the quality to the frame rate.
+		 */
+		double get_frame_time() const noexcept {
+			return frame_time;
+		}
+		
+		/**
+		 * Returns the real time (in seconds) taken by the last update.
+		 * A large share of the frame time spent presenting is a hint
+		 *   that a lower scale would raise the frame rate.
+		 * For asynchronous displays, this is the time spent waiting
+		 *   for the previous frame to be presented.
+		 */
+		double get_present_time() const noexcept {
+			return present_time;
+		}
+		
+		/**
+		 * Sets the display to render at the given fraction of the window's size.
+		 * The display is upscaled to the window on each update,
+		 *   so a scale of 0.5 blits a quarter of the pixels per frame.
+		 * Fractions that divide the window's size exactly, such as 0.5,
+		 *   are upscaled by repeating pixels, which is the fastest.
+		 * Mouse coordinates are scaled to match the display's.
+		 * Sprites sized as ratios of the display should be created
+		 *   after this is called and the display's contents are cleared.
+		 */
+		void set_scale(double s) noexcept {
+			scale = s > 0 && s < 1 ? s : 1;
+			rebuild();
+		}
+		
+		/**
+		 * Returns the fraction of the window's size that the display renders at.
+		 */
+		double get_scale() const noexcept {
+			return scale;
+		}
+		
+		/**
+		 * Sets whether frames are presented on a separate thread.
+		 * The display draws to one of two buffers while the other is
+		 *   copied to the window, so presenting a frame overlaps
+		 *   with drawing the next one.
+		 * After each update, the display holds the frame before last,
+		 *   so each frame should be drawn in full.
+		 * Most platforms, such as macOS, Linux and the mobile platforms,
+		 *   back the window's surface with a renderer that belongs to the
+		 *   main thread, so this should only be used where the surface
+		 *   is a plain framebuffer, as on Windows.
+		 * Renderers belong to the thread that created them, so frames
+		 *   are always presented on the updating thread with a renderer.
+		 */
+		void set_asynchronous(bool async) noexcept {
+			if (async == asynchronous || (async && renderer)) {
+				return;
+			}
+			
+			if (async) {
+				queued = SDL_CreateSemaphore(0);
+				presented = SDL_CreateSemaphore(1);
+				asynchronous = true;
+				rebuild();
+				presenter = SDL_CreateThread(present_frames, "present", this);
+			}
+			
+			else {
+				finish();
+				stopping = true;
+				SDL_SemPost(queued);
+				SDL_WaitThread(presenter, nullptr);
+				presenter = nullptr;
+				stopping = false;
+				SDL_DestroySemaphore(queued);
+				SDL_DestroySemaphore(presented);
+				asynchronous = false;
+				rebuild();
+			}
+		}
+		
+		/**
+		 * Returns true if frames are presented on a separate thread.
+		 */
+		bool get_asynchronous() const noexcept {
+			return asynchronous;
+		}
+		
+		/**
+		 * Returns the number of buffers that the display cycles through.
+		 * Anything that is not redrawn every frame must be redrawn
+		 *   for this many consecutive frames to reach every buffer.
+		 */
+		int get_buffers() const noexcept {
+			return asynchronous ? 2 : 1;
+		}
+		
+		/**
+		 * Sets how frames are presented.
+		 * The renderer backends copy each frame to a streaming texture, which
+		 *   the renderer scales to the window, so they suit devices where
+		 *   SDL's renderer is faster than blitting to the window's surface.
+		 * The present times of each backend, from get_present_time(),
+		 *   can be compared to pick the faster one for a device.
+		 * If the renderer can't be created, such as on platforms that present
+		 *   the window's surface with a renderer of their own, the window's
+		 *   surface is used, so get_backend() should be checked afterwards.
+		 * Frames are never presented asynchronously with a renderer.
+		 * The display's contents are lost.
+		 */
+		void set_backend(Backend b) noexcept {
+			if (b == backend) {
+				return;
+			}
+			
+			if (b != WINDOW_SURFACE) {
+				set_asynchronous(false);
+			}
+			
+			destroy_renderer();
+			
+			if (b != WINDOW_SURFACE) {
+				renderer = SDL_CreateRenderer(
+					window,
+					-1,
+					b == ACCELERATED_RENDERER ? SDL_RENDERER_ACCELERATED : SDL_RENDERER_SOFTWARE
+				);
+			}
+			
+			backend = renderer ? b : WINDOW_SURFACE;
+			rebuild();
+		}
+		
+		/**
+		 * Returns how frames are presented.
+		 */
+		Backend get_backend() const noexcept {
+			return backend;
+		}
+		
+		/**
+		 * Sets whether the window can be resized by the user.
+		 * Rotating a mobile device also resizes its window.
+		 */
+		void set_resizable(bool resizable) noexcept {
+			SDL_SetWindowResizable(window, resizable ? SDL_TRUE : SDL_FALSE);
+		}
+		
+		/**
+		 * Returns true if the window was resized since the last check.
+		 * The display is then rebuilt for the window's new size, so its
+		 *   contents are lost and the next frame should be drawn in full.
+		 * Sprites sized as ratios of the display can be rescaled by a Layout.
+		 * The window's size only changes when events are updated.
+		 */
+		bool resized() noexcept {
+			int w;
+			int h;
+			SDL_GetWindowSize(window, &w, &h);
+			
+			if (w == window_width && h == window_height) {
+				return false;
+			}
+			
+			rebuild();
+			
+			return true;
+		}
+		
+		/**
+		 * Returns a reference to this
+		 *   object casted to a Sprite.
+		 * A legacy member function for when
+		 *   the display had a sprite member.
+		 */
+		Sprite& get_sprite() noexcept {
+			return *this;
+		}
+		
+		/**
+		 * Returns a constant reference to
+		 *   this object casted to a Sprite.
+		 * A legacy member function for when
+		 *   the display had a sprite member.
+		 */
+		const Sprite& get_sprite() const noexcept {
+			return *this;
+		}
+		
+	private:
+		/**
+		 * Creates the window and its sprite.
+		 * Marks the window as self-allocated, which
+		 *   means that the window will be destroyed
+		 *   with this object.
+		 */
+		void create_window(
+			const std::string& title,
+			int width,
+			int height,
+			Uint32 flags
+		) noexcept {
+			window = SDL_CreateWindow(
+				title.c_str(),
+				SDL_WINDOWPOS_UNDEFINED,
+				SDL_WINDOWPOS_UNDEFINED,
+				width,
+				height,
+				flags | DEFAULT_FLAGS
+			);
+			Sprite::operator=(SDL_GetWindowSurface(window));
+			SDL_GetWindowSize(window, &window_width, &window_height);
+			window_allocated = true;
+		}
+		
+		/**
+		 * Destroys the window if the object allocated the memory for it.
+		 */
+		void destroy_window() noexcept {
+			if (window_allocated) {
+				SDL_DestroyWindow(window);
+				window_allocated = false;
+			}
+		}
+		
+		/**
+		 * Recreates the surfaces that are drawn to, for the
+		 *   current scale and presentation mode.
+		 * The display's contents are lost.
+		 */
+		void rebuild() noexcept {
+			finish();
+			SDL_GetWindowSize(window, &window_width, &window_height);
+			
+			// Renderers have no window surface, so their output size is used.
+			int output_width;
+			int output_height;
+			
+			if (renderer) {
+				target = nullptr;
+				SDL_GetRendererOutputSize(renderer, &output_width, &output_height);
+			}
+			
+			else {
+				target = SDL_GetWindowSurface(window);
+				output_width = target->w;
+				output_height = target->h;
+			}
+			
+			int w = std::max(static_cast<int>(output_width * scale), 1);
+			int h = std::max(static_cast<int>(output_height * scale), 1);
+			
+			// The old surfaces are released.
+			Sprite::operator=(target);
+			
+			for (SDL_Surface*& buffer: buffers) {
+				SDL_FreeSurface(buffer);
+				buffer = nullptr;
+			}
+			
+			// Asynchronous displays draw to their buffers and scaled displays,
+			//   or displays with a renderer, draw to a surface of their own.
+			if (asynchronous) {
+				for (SDL_Surface*& buffer: buffers) {
+					buffer = create_buffer(w, h);
+				}
+				
+				drawing = 0;
+				Sprite::operator=(buffers[drawing]);
+			}
+			
+			else if (scale != 1 || renderer) {
+				replace_surface(create_buffer(w, h));
+			}
+			
+			// The renderer streams the surface to a texture of the same size and format.
+			if (renderer) {
+				SDL_DestroyTexture(texture);
+				texture = SDL_CreateTexture(
+					renderer,
+					get_pixel_format(),
+					SDL_TEXTUREACCESS_STREAMING,
+					w,
+					h
+				);
+			}
+			
+			Events::set_mouse_scale(
+				static_cast<double>(width()) / (renderer ? window_width : output_width),
+				static_cast<double>(height()) / (renderer ? window_height : output_height)
+			);
+		}
+		
+		/**
+		 * Destroys the renderer and its texture, if there is one.
+		 */
+		void destroy_renderer() noexcept {
+			if (renderer) {
+				SDL_DestroyTexture(texture);
+				SDL_DestroyRenderer(renderer);
+				renderer = nullptr;
+				texture = nullptr;
+				backend = WINDOW_SURFACE;
+			}
+		}
+		
+		/**
+		 * Returns a new surface of the given size in the window's format.
+		 * The surface is copied without blending.
+		 */
+		SDL_Surface* create_buffer(int w, int h) const noexcept {
+			Uint32 format = target ? target->format->format : SDL_GetWindowPixelFormat(window);
+			SDL_Surface* buffer = SDL_CreateRGBSurfaceWithFormat(
+				0,
+				w,
+				h,
+				SDL_BITSPERPIXEL(format),
+				format
+			);
+			SDL_SetSurfaceBlendMode(buffer, SDL_BLENDMODE_NONE);
+			
+			return buffer;
+		}
+		
+		/**
+		 * Waits for the present thread to present the last frame, if there is one.
+		 */
+		void finish() noexcept {
+			if (asynchronous) {
+				SDL_SemWait(presented);
+				SDL_SemPost(presented);
+			}
+		}
+		
+		/**
+		 * Copies the given surface to the window surface and updates the window.
+		 * With a renderer, the surface is streamed to the texture,
+		 *   which is scaled to the window instead.
+		 */
+		void present(SDL_Surface* source, SDL_Surface* destination) noexcept {
+			if (renderer) {
+				SDL_UpdateTexture(texture, nullptr, source->pixels, source->pitch);
+				SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+				SDL_RenderPresent(renderer);
+				return;
+			}
+			
+			if (source != destination) {
+				upscale(source, destination);
+			}
+			
+			SDL_UpdateWindowSurface(window);
+		}
+		
+		/**
+		 * Presents each queued frame until the display stops being asynchronous.
+		 */
+		static int present_frames(void* data) noexcept {
+			Display& display = *static_cast<Display*>(data);
+			
+			while (true) {
+				SDL_SemWait(display.queued);
+				
+				if (display.stopping) {
+					break;
+				}
+				
+				display.present(display.buffers[display.presenting], display.target);
+				SDL_SemPost(display.presented);
+			}
+			
+			return 0;
+		}
+		
+		/**
+		 * Scales the source up to fill the destination.
+		 * Whole number ratios in the 16 and 32-bit formats repeat pixels and rows.
+		 * Other ratios and formats use SDL's scaler.
+		 */
+		static void upscale(SDL_Surface* source, SDL_Surface* destination) noexcept {
+			int x_ratio = destination->w / source->w;
+			int y_ratio = destination->h / source->h;
+			
+			if (
+				x_ratio * source->w != destination->w
+				|| y_ratio * source->h != destination->h
+				|| source->format->format != destination->format->format
+			) {
+				SDL_BlitScaled(source, nullptr, destination, nullptr);
+			}
+			
+			else if (x_ratio == 1 && y_ratio == 1) {
+				SDL_BlitSurface(source, nullptr, destination, nullptr);
+			}
+			
+			else if (source->format->BytesPerPixel == 4) {
+				repeat<Uint32>(source, destination, x_ratio, y_ratio);
+			}
+			
+			else if (source->format->BytesPerPixel == 2) {
+				repeat<Uint16>(source, destination, x_ratio, y_ratio);
+			}
+			
+			else {
+				SDL_BlitScaled(source, nullptr, destination, nullptr);
+			}
+		}
+		
+		/**
+		 * Upscales the source to the destination by whole number ratios.
+		 * Each source row is widened once and then copied for the remaining rows.
+		 */
+		template<typename T>
+		static void repeat(
+			const SDL_Surface* source,
+			SDL_Surface* destination,
+			int x_ratio,
+			int y_ratio
+		) noexcept {
+			SDL_LockSurface(destination);
+			
+			for (int y = 0; y < source->h; y++) {
+				const T* in = reinterpret_cast<const T*>(static_cast<const Uint8*>(source->pixels) + y * source->pitch);
+				Uint8* first = static_cast<Uint8*>(destination->pixels) + y * y_ratio * destination->pitch;
+				T* out = reinterpret_cast<T*>(first);
+				
+				for (int x = 0; x < source->w; x++) {
+					for (int i = 0; i < x_ratio; i++) {
+						*out++ = in[x];
+					}
+				}
+				
+				for (int i = 1; i < y_ratio; i++) {
+					std::copy(first, first + destination->w * sizeof(T), first + i * destination->pitch);
+				}
+			}
+			
+			SDL_UnlockSurface(destination);
+		}
+		
+        static constexpr Uint32 DEFAULT_FLAGS =
+            SDL_WINDOW_SHOWN
+        ; // The default window flags used for window creation.
+		SDL_Window* window;            // The window for the display.
+		bool window_allocated = false; // True if this class allocated memory for the window.
+		double scale = 1;              // The fraction of the window's size rendered at.
+		int window_width = 0;          // The window's width at the last rebuild.
+		int window_height = 0;         // The window's height at the last rebuild.
+		Uint64 last_update = 0;        // The performance counter at the last update.
+		double frame_time = 0;         // The time between the last two updates.
+		double present_time = 0;       // The time taken by the last update.
+		bool asynchronous = false;     // True if frames are presented on the present thread.
+		SDL_Thread* presenter = nullptr; // The thread that presents frames.
+		SDL_sem* queued = nullptr;     // Posted when a frame is queued for presenting.
+		SDL_sem* presented = nullptr;  // Posted when the queued frame has been presented.
+		bool stopping = false;         // True when the present thread should return.
+		SDL_Surface* buffers[2] = {};  // The buffers of an asynchronous display.
+		int drawing = 0;               // The index of the buffer being drawn to.
+		int presenting = 0;            // The index of the buffer being presented.
+		SDL_Surface* target = nullptr; // The window's surface, or null with a renderer.
+		Backend backend = WINDOW_SURFACE; // How frames are presented.
+		SDL_Renderer* renderer = nullptr; // The renderer of the renderer backends.
+		SDL_Texture* texture = nullptr;   // The texture that frames are streamed to.
+};
+
+/**
+ * A class that records frames, such as the display's, to a capture file.
+ * record() copies each frame into a ring of pooled slots, so the caller
+ *   never waits on the disk.
+ * A writer thread encodes each frame as the difference from the last,
+ *   compresses the runs of equal words that result,
+ *   and appends it to the file in large sequential writes.
+ * Frames recorded while every slot is waiting to be written are dropped.
+ * Captures are stored in the recording machine's byte order
+ *   and are converted to BMP sequences by export_frames().
+ * Instances of this class are neither copiable nor movable.
+ */
+class Recorder {
+	public:
+		/**
+		 * Creates the given capture file and a writer thread for it.
+		 * The given number of slots are allocated for frames the size of the given sprite,
+		 *   and grow if a larger frame is recorded.
+		 * An empty destination makes a recorder that records nothing.
+		 * Throws an exception if the file could not be created.
+		 */
+		Recorder(const std::string& destination, const Sprite& sprite, int count = DEFAULT_SLOTS):
+			slots(destination.empty() ? 0 : std::max(count, 1))
+		{
+			if (destination.empty()) {
+				return;
+			}
+			
+			file = SDL_RWFromFile(destination.c_str(), "wb");
+			
+			// An exception is thrown, if the file couldn't be created.
+			if (!file) {
+				throw std::runtime_error(destination + " could not be opened.");
+			}
+			
+			Uint32 header[] = {MAGIC, CAPTURE_VERSION};
+			SDL_RWwrite(file, header, sizeof(Uint32), 2);
+			
+			for (Frame& frame: this->slots) {
+				frame.pixels.reserve(row_words(sprite.width(), sprite.get_pixel_format()) * sprite.height());
+			}
+			
+			output.reserve(WRITE_WORDS);
+			free_slots = SDL_CreateSemaphore(this->slots.size());
+			filled_slots = SDL_CreateSemaphore(0);
+			writer = SDL_CreateThread(write_frames, "capture", this);
+		}
+		
+		/**
+		 * Instances of this class are not safe to copy.
+		 */
+		Recorder(const Recorder&) = delete;
+		
+		/**
+		 * Writes any frames waiting in the slots and closes the file.
+		 */
+		~Recorder() noexcept {
+			stop();
+		}
+		
+		/**
+		 * Instances of this class are not safe to copy.
+		 */
+		Recorder& operator=(const Recorder&) = delete;
+		
+		/**
+		 * Copies the given frame into a free slot to be written.
+		 * Returns false if the frame was dropped because no slot was free,
+		 *   or if the recorder is not recording.
+		 */
+		bool record(const Sprite& sprite) noexcept {
+			if (!writer) {
+				return false;
+			}
+			
+			if (SDL_SemTryWait(free_slots)) {
+				dropped++;
+				return false;
+			}
+			
+			Frame& frame = slots[head];
+			frame.ticks = SDL_GetTicks();
+			frame.width = sprite.width();
+			frame.height = sprite.height();
+			frame.format = sprite.get_pixel_format();
+			int words = row_words(frame.width, frame.format);
+			frame.pixels.resize(words * frame.height);
+			sprite.read_pixels(frame.pixels.data(), words * sizeof(Uint32));
+			
+			head = (head + 1) % slots.size();
+			recorded++;
+			SDL_SemPost(filled_slots);
+			
+			return true;
+		}
+		
+		/**
+		 * Writes any frames waiting in the slots and closes the file.
+		 * The recorder records nothing after this.
+		 */
+		void stop() noexcept {
+			if (!writer) {
+				return;
+			}
+			
+			// Every slot is taken back once the writer has finished with it.
+			for (std::size_t i = 0; i < slots.size(); i++) {
+				SDL_SemWait(free_slots);
+			}
+			
+			stopping = true;
+			SDL_SemPost(filled_slots);
+			SDL_WaitThread(writer, nullptr);
+			writer = nullptr;
+			SDL_RWclose(file);
+			SDL_DestroySemaphore(free_slots);
+			SDL_DestroySemaphore(filled_slots);
+		}
+		
+		/**
+		 * Returns true if frames are being recorded.
+		 */
+		bool get_recording() const noexcept {
+			return writer;
+		}
+		
+		/**
+		 * Returns the number of frames recorded.
+		 */
+		int get_recorded() const noexcept {
+			return recorded;
+		}
+		
+		/**
+		 * Returns the number of frames dropped because no slot was free.
+		 */
+		int get_dropped() const noexcept {
+			return dropped;
+		}
+		
+		/**
+		 * Writes each frame of the given capture as a BMP.
+		 * The files are named with the destination, followed by
+		 *   the frame's number padded to six digits.
+		 * The capture is split at its key frames, which don't depend on earlier
+		 *   frames, and the segments are decoded and written in parallel
+		 *   by the given number of threads, or by one per CPU if it is 0.
+		 * A frame cut short, as by a crash while recording, ends the sequence.
+		 * Returns the number of frames written.
+		 * Throws an exception if the source could not be opened or is not a capture.
+		 */
+		static int export_frames(const std::string& source, const std::string& destination, int threads = 0) {
+			return export_capture(source, destination, threads, false);
+		}
+		
+		/**
+		 * Writes the frames of the given capture to the given file as raw video.
+		 * Each frame is stored as rows of 24-bit RGB pixels, from the top row,
+		 *   at the size of the first frame, which get_size() returns.
+		 * Frames of other sizes, such as after the window was resized, are scaled to it.
+		 * The frames are decoded and written in parallel, as by export_frames().
+		 * Returns the number of frames written.
+		 * Throws an exception if the source could not be opened or is not a capture,
+		 *   or if the destination could not be created.
+		 */
+		static int export_video(const std::string& source, const std::string& destination, int threads = 0) {
+			return export_capture(source, destination, threads, true);
+		}
+		
+		/**
+		 * Returns the width and height of the first frame of the given capture,
+		 *   or zeros if it has no frames.
+		 * Throws an exception if the source could not be opened or is not a capture.
+		 */
+		static std::array<int, 2> get_size(const std::string& source) {
+			SDL_RWops* file = open_capture(source);
+			Uint32 frame[FRAME_WORDS];
+			std::array<int, 2> size = {0, 0};
+			
+			if (SDL_RWread(file, frame, sizeof(Uint32), FRAME_WORDS) == FRAME_WORDS) {
+				size = {static_cast<int>(frame[1]), static_cast<int>(frame[2])};
+			}
+			
+			SDL_RWclose(file);
+			
+			return size;
+		}
+		
+	private:
+		/**
+		 * A slot for a frame waiting to be written.
+		 */
+		struct Frame {
+			std::vector<Uint32> pixels; // The rows of pixels, each padded to a whole word.
+			Uint32 ticks;               // The time the frame was recorded at.
+			Uint32 width;               // The width of the frame.
+			Uint32 height;              // The height of the frame.
+			Uint32 format;              // The SDL pixel format of the frame.
+		};
+		
+		/**
+		 * A run of frames in a capture, starting at a key frame.
+		 */
+		struct Segment {
+			Sint64 offset; // The position of the key frame in the capture.
+			int first;     // The number of the key frame.
+			int count;     // The number of frames in the segment.
+			int written;   // The number of frames exported.
+		};
+		
+		/**
+		 * A capture being exported by worker threads.
+		 * Each segment is only used by the worker that claims it.
+		 */
+		struct Export {
+			std::string source;            // The capture.
+			std::string destination;       // The BMP prefix or the raw video file.
+			bool video;                    // True if the frames are written as raw video.
+			int width;                     // The width of the raw video.
+			int height;                    // The height of the raw video.
+			std::vector<Segment> segments; // The segments of the capture.
+			SDL_atomic_t next = {};        // The index of the next unclaimed segment.
+		};
+		
+		/**
+		 * Returns the number of words in each row of a frame.
+		 */
+		static int row_words(int width, Uint32 format) noexcept {
+			return (width * SDL_BYTESPERPIXEL(format) + sizeof(Uint32) - 1) / sizeof(Uint32);
+		}
+		
+		/**
+		 * Encodes and writes each filled slot until the recorder stops.
+		 */
+		static int write_frames(void* data) noexcept {
+			Recorder& recorder = *static_cast<Recorder*>(data);
+			
+			while (true) {
+				SDL_SemWait(recorder.filled_slots);
+				
+				if (recorder.stopping) {
+					break;
+				}
+				
+				recorder.encode(recorder.slots[recorder.tail]);
+				recorder.tail = (recorder.tail + 1) % recorder.slots.size();
+				SDL_SemPost(recorder.free_slots);
+				
+				if (recorder.output.size() >= WRITE_WORDS) {
+					recorder.flush();
+				}
+			}
+			
+			recorder.flush();
+			
+			return 0;
+		}
+		
+		/**
+		 * Appends the given frame to the output buffer.
+		 * The frame is XORed with the last frame, so unchanged pixels become
+		 *   zero, unless it is a key frame, which is stored whole.
+		 * Runs of at least MIN_RUN equal words are stored as the word and its
+		 *   count, and the words between them are stored as they are.
+		 */
+		void encode(const Frame& frame) noexcept {
+			bool key = frame.width != previous_width
+				|| frame.height != previous_height
+				|| frame.format != previous_format
+				|| since_key >= KEY_INTERVAL;
+			
+			if (key) {
+				previous.assign(frame.pixels.size(), 0);
+				previous_width = frame.width;
+				previous_height = frame.height;
+				previous_format = frame.format;
+				since_key = 0;
+			}
+			
+			since_key++;
+			delta.resize(frame.pixels.size());
+			
+			for (std::size_t i = 0; i < delta.size(); i++) {
+				delta[i] = frame.pixels[i] ^ previous[i];
+			}
+			
+			std::copy(frame.pixels.begin(), frame.pixels.end(), previous.begin());
+			
+			std::size_t start = output.size();
+			output.insert(output.end(), {
+				frame.ticks,
+				frame.width,
+				frame.height,
+				frame.format,
+				key ? KEY : DELTA,
+				0
+			});
+			
+			std::size_t literal = 0;
+			
+			for (std::size_t i = 0; i < delta.size();) {
+				std::size_t end = i + 1;
+				
+				while (end < delta.size() && delta[end] == delta[i] && end - i < RUN_MASK) {
+					end++;
+				}
+				
+				if (end - i >= MIN_RUN) {
+					append_literals(literal, i);
+					output.push_back(end - i);
+					output.push_back(delta[i]);
+					literal = end;
+				}
+				
+				i = end;
+			}
+			
+			append_literals(literal, delta.size());
+			output[start + FRAME_WORDS - 1] = output.size() - start - FRAME_WORDS;
+		}
+		
+		/**
+		 * Appends the delta words from the first index up to the last as literals.
+		 */
+		void append_literals(std::size_t first, std::size_t last) noexcept {
+			while (first < last) {
+				std::size_t count = std::min(last - first, static_cast<std::size_t>(RUN_MASK));
+				output.push_back(LITERALS | count);
+				output.insert(output.end(), delta.begin() + first, delta.begin() + first + count);
+				first += count;
+			}
+		}
+		
+		/**
+		 * XORs an encoded frame's payload into the given pixels.
+		 * Returns false if the payload does not fit the pixels.
+		 */
+		static bool decode(const std::vector<Uint32>& payload, std::vector<Uint32>& pixels) noexcept {
+			std::size_t in = 0;
+			std::size_t out = 0;
+			
+			while (in < payload.size()) {
+				Uint32 count = payload[in++] & RUN_MASK;
+				bool literals = payload[in - 1] & LITERALS;
+				
+				if (out + count > pixels.size() || in + (literals ? count : 1) > payload.size()) {
+					return false;
+				}
+				
+				for (Uint32 i = 0; i < count; i++) {
+					pixels[out++] ^= payload[literals ? in + i : in];
+				}
+				
+				in += literals ? count : 1;
+			}
+			
+			return out == pixels.size();
+		}
+		
+		/**
+		 * Opens the given capture and checks its header.
+		 * Throws an exception if the capture couldn't be opened or is not a capture.
+		 */
+		static SDL_RWops* open_capture(const std::string& source) {
+			SDL_RWops* file = SDL_RWFromFile(source.c_str(), "rb");
+			
+			// An exception is thrown, if the capture couldn't be opened.
+			if (!file) {
+				throw std::runtime_error(source + " could not be opened.");
+			}
+			
+			Uint32 header[2];
+			
+			if (
+				SDL_RWread(file, header, sizeof(Uint32), 2) != 2
+				|| header[0] != MAGIC
+				|| header[1] != CAPTURE_VERSION
+			) {
+				SDL_RWclose(file);
+				throw std::runtime_error(source + " is not a capture.");
+			}
+			
+			return file;
+		}
+		
+		/**
+		 * Splits the rest of the given capture into segments at its key frames.
+		 * Only the frame headers are read, and the payloads are skipped.
+		 * The segments end at the first frame that was cut short.
+		 */
+		static std::vector<Segment> find_segments(SDL_RWops* file) noexcept {
+			std::vector<Segment> segments;
+			Sint64 size = SDL_RWsize(file);
+			Sint64 position = SDL_RWtell(file);
+			Uint32 frame[FRAME_WORDS];
+			int count = 0;
+			
+			while (SDL_RWread(file, frame, sizeof(Uint32), FRAME_WORDS) == FRAME_WORDS) {
+				Sint64 end = position + static_cast<Sint64>(sizeof(Uint32)) * (FRAME_WORDS + static_cast<Sint64>(frame[5]));
+				
+				if (end > size || (frame[4] != KEY && segments.empty())) {
+					break;
+				}
+				
+				if (frame[4] == KEY) {
+					segments.push_back({position, count, 0, 0});
+				}
+				
+				segments.back().count++;
+				count++;
+				position = end;
+				SDL_RWseek(file, position, RW_SEEK_SET);
+			}
+			
+			return segments;
+		}
+		
+		/**
+		 * Exports the frames of the given capture as BMPs or raw video
+		 *   on the given number of threads, or one per CPU if it is 0.
+		 * Returns the number of frames written.
+		 */
+		static int export_capture(
+			const std::string& source,
+			const std::string& destination,
+			int threads,
+			bool video
+		) {
+			SDL_RWops* file = open_capture(source);
+			Export job;
+			job.source = source;
+			job.destination = destination;
+			job.video = video;
+			job.segments = find_segments(file);
+			SDL_RWclose(file);
+			
+			std::array<int, 2> size = get_size(source);
+			job.width = size[0];
+			job.height = size[1];
+			
+			// The raw video is created, so the workers can write their frames into it.
+			if (video) {
+				SDL_RWops* output = SDL_RWFromFile(destination.c_str(), "wb");
+				
+				// An exception is thrown, if the video couldn't be created.
+				if (!output) {
+					throw std::runtime_error(destination + " could not be opened.");
+				}
+				
+				SDL_RWclose(output);
+			}
+			
+			int count = std::min(threads > 0 ? threads : SDL_GetCPUCount(), static_cast<int>(job.segments.size()));
+			std::vector<SDL_Thread*> workers;
+			
+			for (int i = 1; i < count; i++) {
+				workers.push_back(SDL_CreateThread(export_segments, "export", &job));
+			}
+			
+			// This thread exports segments too.
+			export_segments(&job);
+			
+			for (SDL_Thread* worker: workers) {
+				SDL_WaitThread(worker, nullptr);
+			}
+			
+			int written = 0;
+			
+			for (const Segment& segment: job.segments) {
+				written += segment.written;
+			}
+			
+			return written;
+		}
+		
+		/**
+		 * Decodes and writes the next unclaimed segment until none are left.
+		 * Each worker reads the capture through its own stream
+		 *   and writes raw video frames at their own positions.
+		 */
+		static int export_segments(void* data) noexcept {
+			Export& job = *static_cast<Export*>(data);
+			int count = job.segments.size();
+			SDL_RWops* file = SDL_RWFromFile(job.source.c_str(), "rb");
+			SDL_RWops* output = job.video ? SDL_RWFromFile(job.destination.c_str(), "r+b") : nullptr;
+			SDL_Surface* video = job.video
+				? SDL_CreateRGBSurfaceWithFormat(0, job.width, job.height, 24, SDL_PIXELFORMAT_RGB24)
+				: nullptr
+			;
+			std::vector<Uint32> pixels;
+			std::vector<Uint32> payload;
+			Uint32 frame[FRAME_WORDS];
+			
+			if (!file || (job.video && (!output || !video))) {
+				count = 0;
+			}
+			
+			for (int i = SDL_AtomicAdd(&job.next, 1); i < count; i = SDL_AtomicAdd(&job.next, 1)) {
+				Segment& segment = job.segments[i];
+				SDL_RWseek(file, segment.offset, RW_SEEK_SET);
+				
+				for (int j = 0; j < segment.count; j++) {
+					if (SDL_RWread(file, frame, sizeof(Uint32), FRAME_WORDS) != FRAME_WORDS) {
+						break;
+					}
+					
+					Uint32 width = frame[1];
+					Uint32 height = frame[2];
+					Uint32 format = frame[3];
+					std::size_t size = static_cast<std::size_t>(row_words(width, format)) * height;
+					
+					if (frame[4] == KEY) {
+						pixels.assign(size, 0);
+					}
+					
+					payload.resize(frame[5]);
+					
+					if (
+						pixels.size() != size
+						|| SDL_RWread(file, payload.data(), sizeof(Uint32), payload.size()) != payload.size()
+						|| !decode(payload, pixels)
+					) {
+						break;
+					}
+					
+					SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(
+						pixels.data(),
+						width,
+						height,
+						SDL_BITSPERPIXEL(format),
+						row_words(width, format) * sizeof(Uint32),
+						format
+					);
+					
+					if (job.video) {
+						write_video_frame(surface, video, output, segment.first + j);
+					}
+					
+					else {
+						std::string number = std::to_string(segment.first + j);
+						number.insert(0, std::max(FRAME_DIGITS - static_cast<int>(number.size()), 0), '0');
+						SDL_SaveBMP(surface, (job.destination + number + ".bmp").c_str());
+					}
+					
+					SDL_FreeSurface(surface);
+					segment.written++;
+				}
+			}
+			
+			if (file) {
+				SDL_RWclose(file);
+			}
+			
+			if (output) {
+				SDL_RWclose(output);
+			}
+			
+			SDL_FreeSurface(video);
+			
+			return 0;
+		}
+		
+		/**
+		 * Converts the given frame to the given 24-bit video frame, scaling
+		 *   it if its size differs, and writes it in its place in the output.
+		 */
+		static void write_video_frame(SDL_Surface* frame, SDL_Surface* video, SDL_RWops* output, int number) noexcept {
+			SDL_SetSurfaceBlendMode(frame, SDL_BLENDMODE_NONE);
+			
+			if (frame->w == video->w && frame->h == video->h) {
+				SDL_BlitSurface(frame, nullptr, video, nullptr);
+			}
+			
+			else {
+				SDL_BlitScaled(frame, nullptr, video, nullptr);
+			}
+			
+			int row = video->w * video->format->BytesPerPixel;
+			SDL_RWseek(output, static_cast<Sint64>(row) * video->h * number, RW_SEEK_SET);
+			
+			for (int y = 0; y < video->h; y++) {
+				SDL_RWwrite(output, static_cast<const Uint8*>(video->pixels) + y * video->pitch, row, 1);
+			}
+		}
+		
+		/**
+		 * Writes the output buffer to the file in one write.
+		 */
+		void flush() noexcept {
+			SDL_RWwrite(file, output.data(), sizeof(Uint32), output.size());
+			output.clear();
+		}
+		
+		static constexpr int DEFAULT_SLOTS = 8;            // The default number of frame slots.
+		static constexpr Uint32 MAGIC = 0x434c4453;         // "SDLC" in little-endian order.
+		static constexpr Uint32 CAPTURE_VERSION = 1;        // The version of the capture format.
+		static constexpr int FRAME_WORDS = 6;               // The number of words in a frame's header.
+		static constexpr Uint32 KEY = 1;                    // The header flag of a key frame.
+		static constexpr Uint32 DELTA = 0;                  // The header flag of a difference frame.
+		static constexpr Uint32 LITERALS = 0x80000000;      // The token flag for literal words.
+		static constexpr Uint32 RUN_MASK = 0x7fffffff;      // The bits of a token's count.
+		static constexpr std::size_t MIN_RUN = 3;           // The shortest run stored as a run.
+		static constexpr int KEY_INTERVAL = 300;            // The frames between key frames.
+		static constexpr std::size_t WRITE_WORDS = 1 << 20; // The buffered words that trigger a write.
+		static constexpr int FRAME_DIGITS = 6;              // The digits in exported frame numbers.
+		std::vector<Frame> slots;                           // The ring of frame slots.
+		std::size_t head = 0;                               // The next slot to record to.
+		std::size_t tail = 0;                               // The next slot to write.
+		SDL_sem* free_slots = nullptr;                      // Counts the slots free to record to.
+		SDL_sem* filled_slots = nullptr;                    // Counts the slots waiting to be written.
+		SDL_Thread* writer = nullptr;                       // The thread that writes frames.
+		SDL_RWops* file = nullptr;                          // The capture file.
+		bool stopping = false;                              // True when the writer should return.
+		int recorded = 0;                                   // The number of frames recorded.
+		int dropped = 0;                                    // The number of frames dropped.
+		std::vector<Uint32> previous;                       // The last frame written.
+		Uint32 previous_width = 0;                          // The width of the last frame written.
+		Uint32 previous_height = 0;                         // The height of the last frame written.
+		Uint32 previous_format = 0;                         // The format of the last frame written.
+		int since_key = 0;                                  // The frames written since the last key frame.
+		std::vector<Uint32> delta;                          // The difference from the last frame.
+		std::vector<Uint32> output;                         // The encoded frames waiting to be written.
+};
+
+/**
+ * A class that caches sprites rendered at startup in a file,
+ *   so that later launches read them instead of rendering them again.
+ * The file is stamped with a key, which should change with anything
+ *   the sprites are rendered from, such as the display's size,
+ *   the assets and the version. A file with another key is ignored.
+ * The whole file is read in one read and the sprites are copied from
+ *   memory straight into their surfaces, in the order they are fetched.
+ * After the first miss, every sprite fetched is rendered, and the
+ *   sprites hit before it and rendered since are written as a new file.
+ * Instances of this class are neither copiable nor movable.
+ */
+class SpriteCache {
+	public:
+		/**
+		 * Reads the cache at the given path, if it was saved with the given key.
+		 * An empty path makes a cache that renders every sprite and saves nothing.
+		 */
+		SpriteCache(const std::string& path, Uint64 key) noexcept:
+			path(path),
+			key(key)
+		{
+			if (path.empty()) {
+				return;
+			}
+			
+			SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+			
+			if (!file) {
+				return;
+			}
+			
+			Sint64 size = SDL_RWsize(file);
+			
+			if (size >= static_cast<Sint64>(sizeof(Uint32) * HEADER_WORDS)) {
+				data.resize(size);
+				
+				if (SDL_RWread(file, data.data(), data.size(), 1) != 1) {
+					data.clear();
+				}
+			}
+			
+			SDL_RWclose(file);
+			
+			if (data.empty()) {
+				return;
+			}
+			
+			Uint32 header[HEADER_WORDS];
+			std::copy(data.data(), data.data() + sizeof(header), reinterpret_cast<Uint8*>(header));
+			
+			// A cache with another key, or in another format, is ignored.
+			if (header[0] != MAGIC || header[1] != CACHE_VERSION || header[2] != low(key) || header[3] != high(key)) {
+				data.clear();
+				return;
+			}
+			
+			source = SDL_RWFromConstMem(data.data(), data.size());
+			SDL_RWseek(source, sizeof(header), RW_SEEK_SET);
+			valid = sizeof(header);
 		}
 		
 		/**
-		 * Blits the given sprite to this one.
-		 * The top-left corner of the given sprite is blitted to the
-		 *   coordinates of the top-left vertex of the given Rectangle.
-		 * No scaling is performed.
+		 * Instances of this class are not safe to copy.
 		 */
-		void blit(const Sprite& sprite, const Rectangle& rectangle) noexcept {
-			blit(sprite, rectangle.get_point());
-		}
+		SpriteCache(const SpriteCache&) = delete;
 		
 		/**
-		 * Blits the given sprite to this one.
-		 * The centre of the given sprite is blitted in the
-		 *   given position.
-		 * The position is a ratio of the size of this sprite.
-		 * To blit to the centre, one should use 0.5 as x and y.
-		 * No scaling is perfomed.
+		 * Finishes writing the cache, if any sprite was missed.
 		 */
-		void blit(const Sprite& sprite, double x, double y) noexcept {
-			blit(
-				sprite,
-				static_cast<int>(surface->w * x - sprite.surface->w / 2),
-				static_cast<int>(surface->h * y - sprite.surface->h / 2)
-			);
+		~SpriteCache() noexcept {
+			close();
 		}
 		
 		/**
-		 * Returns the colour in RGB form.
+		 * Instances of this class are not safe to copy.
 		 */
-		static std::array<int, 3> to_rgb(Colour colour) noexcept {
-			std::array<int, 3> rgb;
+		SpriteCache& operator=(const SpriteCache&) = delete;
+		
+		/**
+		 * Returns the next sprite in the cache.
+		 * If it isn't cached, the given function is called to render it,
+		 *   and the rendering is returned and written to the new cache.
+		 */
+		template <typename Render>
+		Sprite fetch(Render render) {
+			Sprite sprite;
 			
-			switch (colour) {
-				case BLACK:
-					rgb[0] = 0;
-					rgb[1] = 0;
-					rgb[2] = 0;
-					break;
-				
-				case RED:
-					rgb[0] = 0xff;
-					rgb[1] = 0;
-					rgb[2] = 0;
-					break;
-					
-				case GREEN:
-					rgb[0] = 0;
-					rgb[1] = 0xff;
-					rgb[2] = 0;
-					break;
-					
-				case BLUE:
-					rgb[0] = 0;
-					rgb[1] = 0;
-					rgb[2] = 0xff;
-					break;
-					
-				case YELLOW:
-					rgb[0] = 0xff;
-					rgb[1] = 0xff;
-					rgb[2] = 0;
-					break;
-					
-				case CYAN:
-					rgb[0] = 0;
-					rgb[1] = 0xff;
-					rgb[2] = 0xff;
-					break;
-					
-				case MAGENTA:
-					rgb[0] = 0xff;
-					rgb[1] = 0;
-					rgb[2] = 0xff;
-					break;
+			if (source && !destination && sprite.deserialise(source)) {
+				valid = SDL_RWtell(source);
+				hits++;
 				
-				case WHITE:
-					rgb[0] = 0xff;
-					rgb[1] = 0xff;
-					rgb[2] = 0xff;
-					break;
-					
-				case GREY:
-					rgb[0] = 0x7f;
-					rgb[1] = 0x7f;
-					rgb[2] = 0x7f;
-					break;
+				return sprite;
 			}
 			
-			return rgb;
+			sprite = render();
+			misses++;
+			store(sprite);
+			
+			return sprite;
 		}
 		
-	private:
 		/**
-		 * Dynamically allocates a new surface with the given dimensions.
-		 * If a surface was already dynamically allocated, it is freed.
+		 * Finishes writing the cache and frees its memory.
+		 * Every sprite fetched after this is rendered and not saved.
 		 */
-		void create_surface(int width, int height) noexcept {
-			destroy_surface();
+		void close() noexcept {
+			if (source) {
+				SDL_RWclose(source);
+				source = nullptr;
+			}
 			
-			surface = SDL_CreateRGBSurface(
-				0, width, height, SURFACE_DEPTH,
-				SURFACE_MASKS[SPRITE_BYTE_ORDER][0], SURFACE_MASKS[SPRITE_BYTE_ORDER][1],
-				SURFACE_MASKS[SPRITE_BYTE_ORDER][2], SURFACE_MASKS[SPRITE_BYTE_ORDER][3]
-			);
+			if (destination) {
+				SDL_RWclose(destination);
+				destination = nullptr;
+			}
 			
-			allocated = true;
+			data.clear();
+			data.shrink_to_fit();
+			path.clear();
 		}
 		
 		/**
-		 * Destroys the surface if it was allocated.
+		 * Returns the number of sprites read from the cache.
 		 */
-		void destroy_surface() noexcept {
-			if (allocated) {
-				SDL_FreeSurface(surface);
-				allocated = false;
+		int get_hits() const noexcept {
+			return hits;
+		}
+		
+		/**
+		 * Returns the number of sprites that had to be rendered.
+		 */
+		int get_misses() const noexcept {
+			return misses;
+		}
+		
+		/**
+		 * Returns the 64-bit FNV-1a hash of the given bytes,
+		 *   continuing from the given hash.
+		 */
+		static Uint64 hash(const void* bytes, std::size_t size, Uint64 seed = FNV_BASIS) noexcept {
+			const Uint8* byte = static_cast<const Uint8*>(bytes);
+			
+			for (std::size_t i = 0; i < size; i++) {
+				seed = (seed ^ byte[i]) * FNV_PRIME;
 			}
+			
+			return seed;
 		}
 		
-		static constexpr int SPRITE_BYTE_ORDER          // Byte ordering of the surface pixels.
-			= SDL_BYTEORDER != SDL_BIG_ENDIAN; 
-		static constexpr int SURFACE_DEPTH = 32;        // The number of bits per pixel.
-		static constexpr Uint32 SURFACE_MASKS[2][4] = { // The position of bits for RGBA.
-			{
-				0xff000000,
-				0x00ff0000,
-				0x0000ff00,
-				0x000000ff
-			},
-			{
-				0x000000ff,
-				0x0000ff00,
-				0x00ff0000,
-				0xff000000
+		/**
+		 * Returns the hash of the given string, continuing from the given hash.
+		 */
+		static Uint64 hash_string(const std::string& text, Uint64 seed = FNV_BASIS) noexcept {
+			return hash(text.data(), text.size(), seed);
+		}
+		
+		/**
+		 * Returns the hash of the contents of the given file, continuing from the given hash.
+		 * A file that can't be read leaves the hash unchanged.
+		 */
+		static Uint64 hash_file(const std::string& source, Uint64 seed = FNV_BASIS) noexcept {
+			SDL_RWops* file = SDL_RWFromFile(source.c_str(), "rb");
+			
+			if (!file) {
+				return seed;
 			}
-		};
+			
+			std::vector<Uint8> contents(std::max(SDL_RWsize(file), static_cast<Sint64>(0)));
+			
+			if (!contents.empty() && SDL_RWread(file, contents.data(), contents.size(), 1) == 1) {
+				seed = hash(contents.data(), contents.size(), seed);
+			}
+			
+			SDL_RWclose(file);
+			
+			return seed;
+		}
 		
-		SDL_Surface* surface;   // The surface containing the pixel data of the sprite.
-		bool allocated = false; // True if the surface's memory was allocated in this class.
+	private:
+		/**
+		 * Writes the given sprite to the new cache.
+		 * The new cache is started on the first miss with the header
+		 *   and the sprites that were hit before it.
+		 * If the cache can't be written, it is abandoned.
+		 */
+		void store(const Sprite& sprite) noexcept {
+			if (path.empty()) {
+				return;
+			}
+			
+			if (!destination) {
+				destination = SDL_RWFromFile(path.c_str(), "wb");
+				
+				if (!destination) {
+					close();
+					return;
+				}
+				
+				Uint32 header[HEADER_WORDS] = {MAGIC, CACHE_VERSION, low(key), high(key)};
+				
+				if (
+					SDL_RWwrite(destination, header, sizeof(header), 1) != 1
+					|| (
+						valid > sizeof(header)
+						&& SDL_RWwrite(destination, data.data() + sizeof(header), valid - sizeof(header), 1) != 1
+					)
+				) {
+					close();
+					return;
+				}
+				
+				if (source) {
+					SDL_RWclose(source);
+					source = nullptr;
+				}
+				
+				data.clear();
+				data.shrink_to_fit();
+			}
+			
+			if (!sprite.serialise(destination)) {
+				close();
+			}
+		}
+		
+		/**
+		 * Returns the low 32 bits of the given key.
+		 */
+		static Uint32 low(Uint64 key) noexcept {
+			return key & 0xffffffff;
+		}
+		
+		/**
+		 * Returns the high 32 bits of the given key.
+		 */
+		static Uint32 high(Uint64 key) noexcept {
+			return key >> 32;
+		}
+		
+		static constexpr int HEADER_WORDS = 4;                     // The number of words in the file's header.
+		static constexpr Uint32 MAGIC = 0x43534453;                // "SDSC" in little-endian order.
+		static constexpr Uint32 CACHE_VERSION = 1;                 // The version of the cache format.
+		static constexpr Uint64 FNV_BASIS = 0xcbf29ce484222325ull; // The FNV-1a offset basis.
+		static constexpr Uint64 FNV_PRIME = 0x100000001b3ull;      // The FNV-1a prime.
+		std::string path;                                          // The path of the cache file.
+		Uint64 key;                                                // The key the cache is stamped with.
+		std::vector<Uint8> data;                                   // The contents of the cache file.
+		SDL_RWops* source = nullptr;                               // The stream of sprites in the contents.
+		SDL_RWops* destination = nullptr;                          // The new cache file, after a miss.
+		std::size_t valid = 0;                                     // The bytes of the contents that were hit.
+		int hits = 0;                                              // The number of sprites read.
+		int misses = 0;                                            // The number of sprites rendered.
 };
 
 /**
- * A class that manages the video system.
- * Each instance of this class corresponds with a window.
- * Instances of this class are not copiable, but are movable.
+ * A class that manages the audio system.
+ * Each instance of this class corresponds to an audio clip.
  */
-class Display: public Sprite {
+class Audio {
 	public:
 		/**
-		 * Makes a window with the given dimensions and no title.
-		 * Passing 0 as both the width and height makes
-		 *   a "windowed fullscreen"-style window.
+		 * Loads an audio clip from the given source.
+		 * Can requeue whenever one wishes to do so.
+		 * The audio is unpaused by default.
+		 */
+		Audio(const std::string& source) {
+			load(source);
+			SDL_PauseAudioDevice(audio_device, false);
+		}
+		
+		/**
+		 * Loads an audio clip from the given source.
+		 * Stores the length of the song in seconds for requeuing.
+		 * The audio is unpaused by default.
+		 */
+		Audio(const std::string& source, double l) {
+			load(source);
+			SDL_PauseAudioDevice(audio_device, false);
+			length = l;
+		}
+		
+		/**
+		 * Audio instances are not safe to be copied.
+		 */
+		Audio(const Audio&) = delete;
+		
+		/**
+		 * Audio instances are safe to be moveed.
+		 */
+		Audio(Audio&& audio) noexcept {
+			operator=(std::move(audio));
+		}
+		
+		/**
+		 * Frees all memory dynamically allocated to this object.
+		 */
+		~Audio() noexcept {
+			free_audio();
+		}
+		
+		/**
+		 * Audio instances are not safe to be copied.
+		 */
+		Audio& operator=(const Audio&) = delete;
+		
+		/**
+		 * Audio instances are safe to be moved.
+		 */
+		Audio& operator=(Audio&& audio) noexcept {
+			// Memory for this object is freed.
+			free_audio();
+			
+			// Data is moved.
+			audio_device = audio.audio_device;
+			audio_buffer = audio.audio_buffer;
+			audio_length = audio.audio_length;
+			last_queue = audio.last_queue;
+			length = audio.length;
+			paused = audio.paused;
+			last_pause = audio.last_pause;
+			allocated = audio.allocated;
+			
+			// The given instance no longer frees its memory.
+			audio.allocated = false;
+			
+			return *this;
+		}
+		
+		/**
+		 * Sets the audio clip to play.
+		 * Manages the queue timer to account for the time paused.
+		 */
+		void play() noexcept {
+			if (paused) {
+				last_queue += Timer::time() - last_pause;
+				paused = false;
+				SDL_PauseAudioDevice(audio_device, false);
+			}
+		}
+		
+		/**
+		 * Sets the audio clip to pause.
+		 * Stores the time of pausing.
 		 */
-		Display(int width = 0, int height = 0) noexcept:
-			Sprite(nullptr)
-		{
-			if (!width && !height) {
-				SDL_DisplayMode display_mode;
-				SDL_GetDesktopDisplayMode(0, &display_mode);
-				width = display_mode.w;
-				height = display_mode.h;
+		void pause() noexcept {
+			if (!paused) {
+				SDL_PauseAudioDevice(audio_device, true);
+				paused = true;
+				last_pause = Timer::time();
 			}
-			
-			create_window("", width, height, 0);
 		}
 		
 		/**
-		 * Makes a window with the given title and dimensions.
-		 * Passing 0 as both the width and height makes
-		 *   a "windowed fullscreen"-style window.
+		 * Queues the audio to play after the current audio clip stops playing.
 		 */
-		Display(const std::string& title, int width = 0, int height = 0) noexcept:
-			Sprite(nullptr)
-		{
-			if (!width && !height) {
-				SDL_DisplayMode display_mode;
-				SDL_GetDesktopDisplayMode(0, &display_mode);
-				width = display_mode.w;
-				height = display_mode.h;
+		void queue() noexcept {
+			if (queuable()) {
+				SDL_QueueAudio(audio_device, audio_buffer, audio_length);
+				last_queue = Timer::time();
 			}
-			
-			create_window(title, width, height, 0);
 		}
 		
 		/**
-		 * Makes a window with its dimensions being a ratio of the window size.
-		 * The window is titleless.
+		 * Returns true if the audio is paused.
 		 */
-		Display(double width, double height) noexcept:
-			Sprite(nullptr)
-		{
-			SDL_DisplayMode display_mode;
-			SDL_GetDesktopDisplayMode(0, &display_mode);
-			
-			create_window(
-				"",
-				width * display_mode.w,
-				height * display_mode.h,
-				0
-			);
+		bool pause_check() const noexcept {
+			return paused;
 		}
 		
 		/**
-		 * Makes a window with its dimensions being a ratio of the window size.
-		 * The window has a title.
+		 * Plays if the audio is paused.
+		 * Pauses if the audio is playing.
 		 */
-		Display(const std::string& title, double width, double height) noexcept:
-			Sprite(nullptr)
-		{
-			SDL_DisplayMode display_mode;
-			SDL_GetDesktopDisplayMode(0, &display_mode);
+		void pause_switch() noexcept {
+			if (paused) {
+				play();
+			}
 			
-			create_window(
-				title,
-				width * display_mode.w,
-				height * display_mode.h,
-				0
-			);
+			else {
+				pause();
+			}
 		}
 		
 		/**
-		 * Constructs a new Display object from the given window.
-		 * The window is not destroyed when this object is destroyed
-		 *   and is the responsibility of the window's creator.
-		 * For this reason, this constructor is not recommended.
+		 * Returns true if the queue() method can queue audio.
 		 */
-		Display(SDL_Window* win) noexcept:
-			Sprite(nullptr)
-		{
-			window = win;
-			Sprite::operator=(SDL_GetWindowSurface(window));
+		bool queuable() const noexcept {
+			return !last_queue || !length || Timer::time() > last_queue + length;
 		}
 		
 		/**
-		 * Display objects should not be copied.
-		 * Copying can cause the window to be destroyed prematurely or twice.
+		 * Clears the audio device's queue.
+		 * The audio will always be queuable after a call to this method.
 		 */
-		Display(const Display&) = delete;
+		void dequeue() noexcept {
+			SDL_ClearQueuedAudio(audio_device);
+			last_queue = 0;
+		}
 		
 		/**
-		 * Display objects can be moved safely.
+		 * A static method that constantly queues the audio passed.
 		 */
-		Display(Display&& display) noexcept:
-			Sprite(nullptr)
-		{
-			operator=(std::move(display));
+		static int thread_queue(void* data) noexcept {
+			Audio& audio = *static_cast<Audio*>(data);
+			
+			while (!audio.pause_check()) {
+				audio.queue();
+			}
+			
+			return 0;
 		}
 		
+	private:
 		/**
-		 * Destroys the window associated with the object if
-		 *   the memory for it was allocated by this object.
-		 * Frees the memory allocated to the Sprite object.
+		 * Loads the song at the given source.
 		 */
-		~Display() noexcept {
-			destroy_window();
+		void load(const std::string& source) {
+			SDL_AudioSpec audio_spec;
+            
+			if (!SDL_LoadWAV(source.c_str(), &audio_spec, &audio_buffer, &audio_length)) {
+                throw std::runtime_error(source + " could not be opened.");
+            }
+            
+			audio_device = SDL_OpenAudioDevice(nullptr, false, &audio_spec, nullptr, 0);
+			allocated = true;
+		}
+	
+		/**
+		 * Closes the associated audio device.
+		 * Frees the audio buffer.
+		 */
+		void free_audio() noexcept {
+			if (allocated) {
+				SDL_CloseAudioDevice(audio_device);
+				SDL_FreeWAV(audio_buffer);
+			}
 		}
+	
+		SDL_AudioDeviceID audio_device;
+		Uint8* audio_buffer;
+		Uint32 audio_length;
+		double last_queue = 0;
+		double length = 0;
+		bool paused = false;
+		double last_pause;
+		bool allocated = false;
+};
+
+/**
+ * A class that pairs the given Sprite with a Rectangle
+ *   constructed for it.
+ * The Sprite and Rectangle can be manipulated
+ *   individually, but there a methods that use
+ *   both objects in tandem.
+ */
+class Button {
+	public:
+		/**
+		 * Constructs a new Button object from given copied Sprite.
+		 * The Rectangle is constructed at the given position
+		 *   and sets the dimensions to the sprite's dimensions.
+		 */
+		Button(const Sprite& s, int x = 0, int y = 0) noexcept:
+			sprite(s),
+			rectangle(x, y, sprite.get_width(), sprite.get_height())
+		{}
 		
 		/**
-		 * Display objects should not be copied.
-		 * Copying can cause the window to be destroyed prematurely or twice.
+		 * Constructs a new Button object from given moved Sprite.
+		 * The Rectangle is constructed at the given position
+		 *   and sets the dimensions to the sprite's dimensions.
 		 */
-		Display& operator=(const Display&) = delete;
+		Button(Sprite&& s, int x = 0, int y = 0) noexcept:
+			sprite(std::move(s)),
+			rectangle(x, y, sprite.get_width(), sprite.get_height())
+		{}
 		
 		/**
-		 * Display objects can be moved safely.
+		 * Constructs a new Button object from the given copied Sprite.
+		 * The Rectangle is constructed with its dimensions set
+		 *   to the sprite's dimensions.
+		 * The Rectangle's position is set to mirror the effects
+		 *   of Sprite::blit(const Sprite&, double, double).
 		 */
-		Display& operator=(Display&& display) noexcept {
-			destroy_window();
-			window = display.window;
-			Sprite::operator=(std::move(static_cast<Sprite&&>(display)));
-			window_allocated = display.window_allocated;
-			display.window_allocated = false;
-			
-			return *this;
-		}
+		Button(
+			const Sprite& s,
+			const Sprite& stemplate,
+			double x = 0.5,
+			double y = 0.5
+		) noexcept:
+			sprite(s),
+			rectangle(
+				stemplate.get_width() * x - sprite.get_width() / 2,
+				stemplate.get_height() * y - sprite.get_height() / 2,
+				sprite.get_width(),
+				sprite.get_height()
+			)
+		{}
 		
 		/**
-		 * Initialises the display with the given window.
-		 * The window is not destroyed when this object is destroyed
-		 *   and is the responsibility of the window's creator.
-		 * For this reason, this use of this method is not recommended.
+		 * Constructs a new Button object from the given moved Sprite.
+		 * The Rectangle is constructed with its dimensions set
+		 *   to the sprite's dimensions.
+		 * The Rectangle's position is set to mirror the effects
+		 *   of Sprite::blit(const Sprite&, double, double).
 		 */
-		Display& operator=(SDL_Window* win) noexcept {
-			destroy_window();
-			window = win;
-			Sprite::operator=(SDL_GetWindowSurface(window));
-			
-			return *this;
-		}
+		Button(
+			Sprite&& s,
+			const Sprite& stemplate,
+			double x = 0.5,
+			double y = 0.5
+		) noexcept:
+			sprite(std::move(s)),
+			rectangle(
+				stemplate.get_width() * x - sprite.get_width() / 2,
+				stemplate.get_height() * y - sprite.get_height() / 2,
+				sprite.get_width(),
+				sprite.get_height()
+			)
+		{}
+		
+		/**
+		 * Constructs a new Button object that blits the given view.
+		 * The Rectangle is constructed at the given position
+		 *   and sets the dimensions to the view's dimensions.
+		 * The Button's own sprite is left empty.
+		 */
+		Button(const SpriteView& v, int x = 0, int y = 0) noexcept:
+			view(v),
+			rectangle(x, y, view.width(), view.height())
+		{}
+		
+		/**
+		 * Constructs a new Button object that blits the given view.
+		 * The Rectangle is constructed with its dimensions set
+		 *   to the view's dimensions.
+		 * The Rectangle's position is set to mirror the effects
+		 *   of Sprite::blit(const SpriteView&, double, double).
+		 * The Button's own sprite is left empty.
+		 */
+		Button(
+			const SpriteView& v,
+			const Sprite& stemplate,
+			double x = 0.5,
+			double y = 0.5
+		) noexcept:
+			view(v),
+			rectangle(
+				stemplate.get_width() * x - view.width() / 2,
+				stemplate.get_height() * y - view.height() / 2,
+				view.width(),
+				view.height()
+			)
+		{}
 		
 		/**
-		 * Updates the window's surface.
+		 * Blits the Button's view, or its sprite if it has no view,
+		 *   to the given sprite using the Button's Rectangle.
 		 */
-		void update() noexcept {
-			SDL_UpdateWindowSurface(window);
+		void blit_to(Sprite& s) const noexcept {
+			if (view) {
+				s.blit(view, rectangle.get_x(), rectangle.get_y());
+			}
+			
+			else {
+				s.blit(sprite, rectangle.get_x(), rectangle.get_y());
+			}
 		}
 		
 		/**
-		 * Returns a reference to this
-		 *   object casted to a Sprite.
-		 * A legacy member function for when
-		 *   the display had a sprite member.
+		 * Returns a reference to the button's sprite.
 		 */
 		Sprite& get_sprite() noexcept {
-			return *this;
+			return sprite;
 		}
 		
 		/**
-		 * Returns a constant reference to
-		 *   this object casted to a Sprite.
-		 * A legacy member function for when
-		 *   the display had a sprite member.
+		 * Returns a constant reference to the button's sprite.
 		 */
 		const Sprite& get_sprite() const noexcept {
-			return *this;
+			return sprite;
 		}
 		
-	private:
 		/**
-		 * Creates the window and its sprite.
-		 * Marks the window as self-allocated, which
-		 *   means that the window will be destroyed
-		 *   with this object.
+		 * Returns a reference to the button's rectangle.
 		 */
-		void create_window(
-			const std::string& title,
-			int width,
-			int height,
-			Uint32 flags
-		) noexcept {
-			window = SDL_CreateWindow(
-				title.c_str(),
-				SDL_WINDOWPOS_UNDEFINED,
-				SDL_WINDOWPOS_UNDEFINED,
-				width,
-				height,
-				flags | DEFAULT_FLAGS
-			);
-			Sprite::operator=(SDL_GetWindowSurface(window));
-			window_allocated = true;
+		Rectangle& get_rectangle() noexcept {
+			return rectangle;
 		}
 		
 		/**
-		 * Destroys the window if the object allocated the memory for it.
+		 * Returns a constant reference to the button's rectangle.
 		 */
-		void destroy_window() noexcept {
-			if (window_allocated) {
-				SDL_DestroyWindow(window);
-				window_allocated = false;
-			}
+		const Rectangle& get_rectangle() const noexcept {
+			return rectangle;
 		}
-		
-        static constexpr Uint32 DEFAULT_FLAGS =
-            SDL_WINDOW_SHOWN
-        ; // The default window flags used for window creation.
-		SDL_Window* window;            // The window for the display.
-		bool window_allocated = false; // True if this class allocated memory for the window.
+	
+	private:
+		Sprite sprite;
+		SpriteView view;
+		Rectangle rectangle;
 };
+//}
 
+// Renderer Classes
+//{
 /**
- * A class that manages the audio system.
- * Each instance of this class corresponds to an audio clip.
+ * An abstract base class for renderer subclasses to inherit from.
+ * All renderers should be able to render a single line from a string input.
  */
-class Audio {
+class Renderer {
 	public:
 		/**
-		 * Loads an audio clip from the given source.
-		 * Can requeue whenever one wishes to do so.
-		 * The audio is unpaused by default.
+		 * An enumeration for the justification in lined_render().
 		 */
-		Audio(const std::string& source) {
-			load(source);
-			SDL_PauseAudioDevice(audio_device, false);
-		}
+		enum Justification {
+			LEFT_JUSTIFY,
+			CENTRE_JUSTIFY,
+			RIGHT_JUSTIFY
+		};
 		
 		/**
-		 * Loads an audio clip from the given source.
-		 * Stores the length of the song in seconds for requeuing.
-		 * The audio is unpaused by default.
+		 * Returns a sprite that is a single line rendering of the passed string.
+		 * The size (in pixels) of the characters must be specified.
 		 */
-		Audio(const std::string& source, double l) {
-			load(source);
-			SDL_PauseAudioDevice(audio_device, false);
-			length = l;
-		}
+		virtual Sprite render(const std::string&, int, int, int) const noexcept = 0;
 		
 		/**
-		 * Audio instances are not safe to be copied.
+		 * Returns a sprite that is a single line rendering of the passed string.
+		 * The size (in pixels) of the characters must be specified.
+		 * Uses ratios of the given sprite to determine the character size.
 		 */
-		Audio(const Audio&) = delete;
+		Sprite render(
+			const Sprite& ratio_base,
+			const std::string& text,
+			double width,
+			double height,
+			double separation = 0
+		) const noexcept {
+			return render(
+				text,
+				width * ratio_base.width(),
+				height * ratio_base.height(),
+				separation * ratio_base.width()
+			);
+		}
 		
 		/**
-		 * Audio instances are safe to be moveed.
+		 * Returns a sprite that is a multiple line rendering of the passed string.
+		 * The size (in pixels) of the characters must be specified.
+		 * The maximum width of the sprite and the space between lines can be defined.
+		 * The justification of the resulting sprite can be defined.
+		 * The line breaks are found in a single pass over the text and the
+		 *   glyphs are rendered directly to the returned sprite.
 		 */
-		Audio(Audio&& audio) noexcept {
-			operator=(std::move(audio));
+		Sprite lined_render(
+			const std::string& text,
+			int width,
+			int height,
+			int x_separation = 0,
+			int y_separation = 0,
+			int max_width = 0,
+			Justification justification = CENTRE_JUSTIFY
+		) const noexcept {
+			// If the text is empty an empty sprite is returned.
+			if (text != "") {
+				// The maximum number of characters in a line.
+				int max_characters = max_width / (width + x_separation);
+				// The widest line's length in characters.
+				int max_length = layout(text, max_characters);
+				
+				// The full sprite is initialised for rendering to.
+				int length = lines.size();
+				Sprite sprite(
+					line_width(max_length, width, x_separation),
+					length * (height + y_separation) - y_separation
+				);
+				int true_width = sprite.get_width();
+				
+				// The position of the lines is determined by the justification.
+				int position;
+				
+				// The lines are rendered directly onto the sprite.
+				for (int i = 0; i < length; i++) {
+					int line_length = lines[i].second;
+					
+					// The position is found.
+					switch (justification) {
+						// Centre justify.
+						case CENTRE_JUSTIFY:
+							position = (true_width - line_width(line_length, width, x_separation)) / 2;
+							break;
+							
+						// Left justify.
+						case LEFT_JUSTIFY:
+							position = 0;
+							break;
+							
+						// Right justify.
+						case RIGHT_JUSTIFY:
+							position = true_width - line_width(line_length, width, x_separation);
+							break;
+					}
+					
+					render_line(
+						sprite,
+						text.data() + lines[i].first,
+						line_length,
+						position,
+						i * (height + y_separation),
+						width,
+						height,
+						x_separation
+					);
+				}
+				
+				return sprite;
+			}
+			
+			return Sprite();
 		}
 		
 		/**
-		 * Frees all memory dynamically allocated to this object.
+		 * Returns a sprite that is a multiple line rendering of the passed string.
+		 * The size (in pixels) of the characters must be specified.
+		 * The maximum width of the sprite and the space between lines can be defined.
+		 * The justification of the resulting sprite can be defined.
+		 * Uses ratios of the given sprite to determine the character size.
 		 */
-		~Audio() noexcept {
-			free_audio();
+		Sprite lined_render(
+			const Sprite& ratio_base,
+			const std::string& text,
+			double width,
+			double height,
+			double x_separation = 0,
+			double y_separation = 0,
+			double max_width = 0,
+			Justification justification = CENTRE_JUSTIFY
+		) const noexcept {
+			return lined_render(
+				text,
+				width * ratio_base.width(),
+				height * ratio_base.height(),
+				x_separation * ratio_base.width(),
+				y_separation * ratio_base.height(),
+				max_width * ratio_base.width(),
+				justification
+			);
 		}
-		
+	
+	protected:
 		/**
-		 * Audio instances are not safe to be copied.
+		 * Renders the given character to the given sprite.
+		 * The character is scaled to fill the rectangle with its top-left
+		 *   vertex at the given coordinates and the given dimensions.
+		 * Characters that cannot be rendered are skipped.
 		 */
-		Audio& operator=(const Audio&) = delete;
+		virtual void render_character(Sprite&, char, int, int, int, int) const noexcept = 0;
 		
 		/**
-		 * Audio instances are safe to be moved.
+		 * Renders the given number of characters as a single line to the given sprite.
+		 * The top-left vertex of the line is placed at the given coordinates.
 		 */
-		Audio& operator=(Audio&& audio) noexcept {
-			// Memory for this object is freed.
-			free_audio();
-			
-			// Data is moved.
-			audio_device = audio.audio_device;
-			audio_buffer = audio.audio_buffer;
-			audio_length = audio.audio_length;
-			last_queue = audio.last_queue;
-			length = audio.length;
-			paused = audio.paused;
-			last_pause = audio.last_pause;
-			allocated = audio.allocated;
-			
-			// The given instance no longer frees its memory.
-			audio.allocated = false;
-			
-			return *this;
+		void render_line(
+			Sprite& sprite,
+			const char* text,
+			int length,
+			int x,
+			int y,
+			int width,
+			int height,
+			int separation = 0
+		) const noexcept {
+			for (int i = 0; i < length; i++) {
+				render_character(sprite, text[i], x + i * (width + separation), y, width, height);
+			}
 		}
 		
 		/**
-		 * Sets the audio clip to play.
-		 * Manages the queue timer to account for the time paused.
+		 * Returns the width (in pixels) of a line with the given number of characters.
 		 */
-		void play() noexcept {
-			if (paused) {
-				last_queue += Timer::time() - last_pause;
-				paused = false;
-				SDL_PauseAudioDevice(audio_device, false);
+		static int line_width(int length, int width, int separation) noexcept {
+			return length ? length * (width + separation) - separation : 0;
+		}
+	
+	private:
+		/**
+		 * Splits the text into lines that should be rendered separately.
+		 * New lines always split the text and spaces split the text when a
+		 *   line would otherwise exceed the maximum number of characters.
+		 * A maximum of zero allows for lines of any length.
+		 * Each line is stored as the offset and length of a substring of the
+		 *   text, so the text is not copied.
+		 * Returns the length of the longest line.
+		 */
+		int layout(const std::string& text, int max_characters) const noexcept {
+			lines.clear();
+			int length = text.length();
+			int max_length = 0;
+			// The start of the current line.
+			int start = 0;
+			// The end of the last word that fit on the current line.
+			int end = 0;
+			// True if no words have been placed on the current line.
+			bool empty = true;
+			
+			// The text is walked one word at a time.
+			// The word ending at the end of the text ends the final line.
+			for (int i = 0; i <= length; i++) {
+				if (i == length || text[i] == ' ' || text[i] == '\n') {
+					// The word is joined to the current line if there is room.
+					// The first word of a line is always placed.
+					if (empty || !max_characters || i - start <= max_characters) {
+						end = i;
+						empty = false;
+					}
+					
+					// Else, the line is finished and the word starts a new one.
+					else {
+						lines.emplace_back(start, end - start);
+						max_length = std::max(max_length, end - start);
+						start = end + 1;
+						end = i;
+					}
+					
+					// New lines and the end of the text finish the current line.
+					if (i == length || text[i] == '\n') {
+						lines.emplace_back(start, end - start);
+						max_length = std::max(max_length, end - start);
+						start = i + 1;
+						end = start;
+						empty = true;
+					}
+				}
 			}
+			
+			return max_length;
 		}
 		
+		// The offset and length of each line found by layout().
+		// Kept between calls so that its storage is reused.
+		mutable std::vector<std::pair<int, int>> lines;
+};
+
+/**
+ * A class that manages the rendering of the sprites of
+ *   characters and numbers to other sprites.
+ * The characters and numbers are monospaced and only
+ *   capital numbers are available.
+ */
+template<int N = System::RENDERER>
+class BasicRenderer: public Renderer {
+	public:
 		/**
-		 * Sets the audio clip to pause.
-		 * Stores the time of pausing.
+		 * Constructs a new Renderer object.
+		 * Sprites are created for each letter and number
+		 *   that has a source passed.
+		 * The sources should be an array of strings and the count
+		 *   should be the number of strings passed.
+		 * The array of sources should start with the letters
+		 *   in alphabetical order and then the numbers in
+		 *   ascending order (A-Z then 0-9).
+		 * The Boolean, numbers_first, indicates that the numbers
+		 *   come before the letters in the array.
+		 * An empty string can be used to not load a specific character.
 		 */
-		void pause() noexcept {
-			if (!paused) {
-				SDL_PauseAudioDevice(audio_device, true);
-				paused = true;
-				last_pause = Timer::time();
-			}
+		BasicRenderer(
+			const std::array<std::string, N>& sources,
+			bool numbers_first = false
+		) noexcept {
+			load_sprites(sources, N, numbers_first);
 		}
-		
+	
 		/**
-		 * Queues the audio to play after the current audio clip stops playing.
+		 * Returns a sprite that is a rendering of the passed string.
+		 * The size (in pixels) of the characters must be specified.
+		 * The text is converted to uppercase.
 		 */
-		void queue() noexcept {
-			if (queuable()) {
-				SDL_QueueAudio(audio_device, audio_buffer, audio_length);
-				last_queue = Timer::time();
+		Sprite render(
+			const std::string& text,
+			int width,
+			int height,
+			int separation = 0
+		) const noexcept {
+			int length = text.length();
+			
+			if (length) {
+				Sprite rendering(line_width(length, width, separation), height);
+				render_line(rendering, text.data(), length, 0, 0, width, height, separation);
+				
+				return rendering;
 			}
+			
+			return Sprite();
 		}
 		
+	protected:
 		/**
-		 * Returns true if the audio is paused.
+		 * Renders the given character to the given sprite.
+		 * The character is converted to uppercase.
 		 */
-		bool pause_check() const noexcept {
-			return paused;
+		void render_character(
+			Sprite& sprite,
+			char character,
+			int x,
+			int y,
+			int width,
+			int height
+		) const noexcept {
+			// The character is converted to uppercase.
+			if ('a' <= character && character <= 'z') {
+				character -= 0x20;
+			}
+			
+			// A letter is rendered
+			if ('A' <= character && character <= 'Z') {
+				sprite.blit(*letters[character - 'A'], x, y, width, height);
+			}
+			
+			// A number is rendered
+			else if ('0' <= character && character <= '9') {
+				sprite.blit(*numbers[character - '0'], x, y, width, height);
+			}
 		}
 		
+	private:
 		/**
-		 * Plays if the audio is paused.
-		 * Pauses if the audio is playing.
+		 * Constructs sprites for the given characters.
 		 */
-		void pause_switch() noexcept {
-			if (paused) {
-				play();
+		void load_sprites(
+			const std::array<std::string, N>& sources,
+			int count,
+			bool numbers_first
+		) noexcept {
+			// Constructs the numbers first.
+			if (numbers_first) {
+				load_numbers(sources, 0, count);
+				load_letters(sources, System::NUMBERS, count - System::NUMBERS);
 			}
 			
+			// Constructs the letters first.
 			else {
-				pause();
+				load_letters(sources, 0, count);
+				load_numbers(sources, System::LETTERS, count - System::LETTERS);
 			}
 		}
 		
 		/**
-		 * Returns true if the queue() method can queue audio.
+		 * Constructs sprites for the given numbers.
 		 */
-		bool queuable() const noexcept {
-			return !last_queue || !length || Timer::time() > last_queue + length;
+		void load_numbers(
+			const std::array<std::string, N>& sources,
+			int offset,
+			int count
+		) noexcept {
+			for (int i = 0; i < System::NUMBERS; i++) {
+				// The sprite is loaded if the source was given.
+				if (i < count && sources[i + offset] != "") {
+					numbers[i] = std::make_unique<Sprite>(sources[i + offset]);
+				}
+				
+				// Else, an empty sprite is loaded.
+				else {
+					numbers[i] = std::make_unique<Sprite>();
+				}
+			}
 		}
 		
 		/**
-		 * Clears the audio device's queue.
-		 * The audio will always be queuable after a call to this method.
+		 * Constructs sprites for the given letters.
 		 */
-		void dequeue() noexcept {
-			SDL_ClearQueuedAudio(audio_device);
-			last_queue = 0;
+		void load_letters(
+			const std::array<std::string, N>& sources,
+			int offset,
+			int count
+		) noexcept {
+			for (int i = 0; i < System::LETTERS; i++) {
+				// The sprite is loaded if the source was given.
+				if (i < count && sources[i + offset] != "") {
+					letters[i] = std::make_unique<Sprite>(sources[i + offset]);
+				}
+				
+				// Else, an empty sprite is loaded.
+				else {
+					letters[i] = std::make_unique<Sprite>();
+				}
+			}
 		}
 		
+		std::array<std::unique_ptr<Sprite>, System::LETTERS> letters;
+		std::array<std::unique_ptr<Sprite>, System::NUMBERS> numbers;
+};
+
+/**
+ * A class that manages the rendering of the
+ *   sprites of characters to other sprites.
+ * Any character can be rendered and the
+ *   rendering is defined by the user.
+ */
+template<int N>
+class FullRenderer: public Renderer {
+	public:
 		/**
-		 * A static method that constantly queues the audio passed.
+		 * Loads sprites for the given characters using the given sources.
 		 */
-		static int thread_queue(void* data) noexcept {
-			Audio& audio = *static_cast<Audio*>(data);
-			
-			while (!audio.pause_check()) {
-				audio.queue();
+		FullRenderer(
+			const std::array<char, N>& chars,
+			const std::array<std::string, N>& sources
+		) noexcept {
+			for (int i = 0; i < N; i++) {
+				characters[i] = chars[i];
+				sprites[i] = std::make_unique<Sprite>(
+					sources[i]
+				);
 			}
-			
-			return 0;
 		}
 		
-	private:
 		/**
-		 * Loads the song at the given source.
+		 * Returns a sprite that is a rendering of the passed string.
+		 * The size (in pixels) of the characters must be specified.
+		 * Only characters that had a sprite loaded for them are rendered.
 		 */
-		void load(const std::string& source) {
-			SDL_AudioSpec audio_spec;
-            
-			if (!SDL_LoadWAV(source.c_str(), &audio_spec, &audio_buffer, &audio_length)) {
-                throw std::runtime_error(source + " could not be opened.");
-            }
-            
-			audio_device = SDL_OpenAudioDevice(nullptr, false, &audio_spec, nullptr, 0);
-			allocated = true;
+		Sprite render(
+			const std::string& text,
+			int width,
+			int height,
+			int separation = 0
+		) const noexcept {
+			int length = text.length();
+			
+			if (length) {
+				Sprite rendering(line_width(length, width, separation), height);
+				render_line(rendering, text.data(), length, 0, 0, width, height, separation);
+				
+				return rendering;
+			}
+			
+			return Sprite();
 		}
 	
+	protected:
 		/**
-		 * Closes the associated audio device.
-		 * Frees the audio buffer.
+		 * Renders the given character to the given sprite.
+		 * The character is only rendered, if it had a sprite loaded for it.
 		 */
-		void free_audio() noexcept {
-			if (allocated) {
-				SDL_CloseAudioDevice(audio_device);
-				SDL_FreeWAV(audio_buffer);
+		void render_character(
+			Sprite& sprite,
+			char character,
+			int x,
+			int y,
+			int width,
+			int height
+		) const noexcept {
+			int index = -1;
+			
+			// The character is searched for.
+			for (int j = 0; j < N; j++) {
+				if (character == characters[j]) {
+					index = j;
+				}
+			}
+			
+			// The character is rendered, if it was found.
+			if (index >= 0) {
+				sprite.blit(*sprites[index], x, y, width, height);
 			}
 		}
 	
-		SDL_AudioDeviceID audio_device;
-		Uint8* audio_buffer;
-		Uint32 audio_length;
-		double last_queue = 0;
-		double length = 0;
-		bool paused = false;
-		double last_pause;
-		bool allocated = false;
+	private:
+		std::array<char, N> characters;                 // The renderable characters.
+		std::array<std::unique_ptr<Sprite>, N> sprites; // The sprites for rendering.
 };
 
 /**
- * A class that pairs the given Sprite with a Rectangle
- *   constructed for it.
- * The Sprite and Rectangle can be manipulated
- *   individually, but there a methods that use
- *   both objects in tandem.
+ * A class that renders characters from a signed distance field atlas.
+ * Any character can be rendered and the characters
+ *   are defined by the user, like FullRenderer.
+ * The atlas should be made with the sdfatlas tool, which stores one
+ *   square distance field per character in a single greyscale strip.
+ * Characters are rasterised at any size from the same atlas,
+ *   so memory use does not depend on the number of text sizes used.
+ * Instances of this class are not copiable.
  */
-class Button {
+template<int N>
+class SdfRenderer: public Renderer {
 	public:
-		/**
-		 * Constructs a new Button object from given copied Sprite.
-		 * The Rectangle is constructed at the given position
-		 *   and sets the dimensions to the sprite's dimensions.
-		 */
-		Button(const Sprite& s, int x = 0, int y = 0) noexcept:
-			sprite(s),
-			rectangle(x, y, sprite.get_width(), sprite.get_height())
-		{}
-		
-		/**
-		 * Constructs a new Button object from given moved Sprite.
-		 * The Rectangle is constructed at the given position
-		 *   and sets the dimensions to the sprite's dimensions.
-		 */
-		Button(Sprite&& s, int x = 0, int y = 0) noexcept:
-			sprite(std::move(s)),
-			rectangle(x, y, sprite.get_width(), sprite.get_height())
-		{}
+		// The fraction of the cell size that the distance field
+		//   spans on each side of an edge (must match sdfatlas).
+		static constexpr double SPREAD = 0.125;
 		
 		/**
-		 * Constructs a new Button object from the given copied Sprite.
-		 * The Rectangle is constructed with its dimensions set
-		 *   to the sprite's dimensions.
-		 * The Rectangle's position is set to mirror the effects
-		 *   of Sprite::blit(const Sprite&, double, double).
+		 * Loads the atlas at the given source for the given characters.
+		 * The characters are rendered in the given colour on black.
+		 * Throws if the atlas could not be opened or does not
+		 *   have a cell for each character.
 		 */
-		Button(
-			const Sprite& s,
-			const Sprite& stemplate,
-			double x = 0.5,
-			double y = 0.5
-		) noexcept:
-			sprite(s),
-			rectangle(
-				stemplate.get_width() * x - sprite.get_width() / 2,
-				stemplate.get_height() * y - sprite.get_height() / 2,
-				sprite.get_width(),
-				sprite.get_height()
-			)
-		{}
+		SdfRenderer(
+			const std::array<char, N>& chars,
+			const std::string& source,
+			int red,
+			int green,
+			int blue
+		):
+			colour({red, green, blue})
+		{
+			load_atlas(source);
+			
+			// Characters without a cell are not rendered.
+			indices.fill(-1);
+			
+			for (int i = 0; i < N; i++) {
+				indices[static_cast<unsigned char>(chars[i])] = i;
+			}
+		}
 		
 		/**
-		 * Constructs a new Button object from the given moved Sprite.
-		 * The Rectangle is constructed with its dimensions set
-		 *   to the sprite's dimensions.
-		 * The Rectangle's position is set to mirror the effects
-		 *   of Sprite::blit(const Sprite&, double, double).
+		 * Loads the atlas at the given source for the given characters.
+		 * The characters are rendered in the given predefined colour on black.
 		 */
-		Button(
-			Sprite&& s,
-			const Sprite& stemplate,
-			double x = 0.5,
-			double y = 0.5
-		) noexcept:
-			sprite(std::move(s)),
-			rectangle(
-				stemplate.get_width() * x - sprite.get_width() / 2,
-				stemplate.get_height() * y - sprite.get_height() / 2,
-				sprite.get_width(),
-				sprite.get_height()
+		SdfRenderer(
+			const std::array<char, N>& chars,
+			const std::string& source,
+			Sprite::Colour colour = Sprite::WHITE
+		):
+			SdfRenderer(
+				chars,
+				source,
+				Sprite::to_rgb(colour)[0],
+				Sprite::to_rgb(colour)[1],
+				Sprite::to_rgb(colour)[2]
 			)
 		{}
 		
 		/**
-		 * Blits the Button's sprite to the given sprite using
-		 *   the Button's Rectangle.
+		 * Instances of this class are not safe to copy.
 		 */
-		void blit_to(Sprite& s) const noexcept {
-			s.blit(sprite, rectangle.get_x(), rectangle.get_y());
-		}
+		SdfRenderer(const SdfRenderer&) = delete;
 		
 		/**
-		 * Returns a reference to the button's sprite.
+		 * Frees the cached glyph surface.
 		 */
-		Sprite& get_sprite() noexcept {
-			return sprite;
+		~SdfRenderer() noexcept {
+			if (glyph) {
+				SDL_FreeSurface(glyph);
+			}
 		}
 		
 		/**
-		 * Returns a constant reference to the button's sprite.
+		 * Instances of this class are not safe to copy.
 		 */
-		const Sprite& get_sprite() const noexcept {
-			return sprite;
-		}
+		SdfRenderer& operator=(const SdfRenderer&) = delete;
 		
 		/**
-		 * Returns a reference to the button's rectangle.
+		 * Returns a sprite that is a rendering of the passed string.
+		 * The size (in pixels) of the characters must be specified.
+		 * Only characters that have a cell in the atlas are rendered.
 		 */
-		Rectangle& get_rectangle() noexcept {
-			return rectangle;
+		Sprite render(
+			const std::string& text,
+			int width,
+			int height,
+			int separation = 0
+		) const noexcept {
+			int length = text.length();
+			
+			if (length) {
+				Sprite rendering(line_width(length, width, separation), height);
+				render_line(rendering, text.data(), length, 0, 0, width, height, separation);
+				
+				return rendering;
+			}
+			
+			return Sprite();
 		}
-		
+	
+	protected:
 		/**
-		 * Returns a constant reference to the button's rectangle.
+		 * Renders the given character to the given sprite.
+		 * The distance field is sampled bilinearly and thresholded,
+		 *   with a one pixel ramp at the edge for antialiasing.
 		 */
-		const Rectangle& get_rectangle() const noexcept {
-			return rectangle;
+		void render_character(
+			Sprite& sprite,
+			char character,
+			int x,
+			int y,
+			int width,
+			int height
+		) const noexcept {
+			int index = indices[static_cast<unsigned char>(character)];
+			
+			if (index < 0 || width <= 0 || height <= 0) {
+				return;
+			}
+			
+			prepare(width, height);
+			
+			// The threshold maps a distance sample to coverage.
+			// The distance is converted to pixels of the rendering,
+			//   so the edge ramp is one pixel wide at every size.
+			float scale = SPREAD * std::min(width, height) / (EDGE - 1);
+			float bias = 0.5f - EDGE * scale;
+			const Uint8* cell = atlas.data() + index * cell_size;
+			int atlas_width = N * cell_size;
+			
+			for (int j = 0; j < height; j++) {
+				const Uint8* top = cell + rows[j] * atlas_width;
+				const Uint8* bottom = cell + std::min(rows[j] + 1, cell_size - 1) * atlas_width;
+				float fraction = row_weights[j];
+				
+				// The two nearest atlas rows are blended.
+				for (int i = 0; i < cell_size; i++) {
+					blended[i] = top[i] + fraction * (bottom[i] - top[i]);
+				}
+				
+				// The blended row is resampled to the rendering's width.
+				for (int i = 0; i < width; i++) {
+					int column = columns[i];
+					int next = std::min(column + 1, cell_size - 1);
+					samples[i] = blended[column] + column_weights[i] * (blended[next] - blended[column]);
+				}
+				
+				threshold(
+					samples.data(),
+					reinterpret_cast<Uint32*>(static_cast<Uint8*>(glyph->pixels) + j * glyph->pitch),
+					width,
+					scale,
+					bias
+				);
+			}
+			
+			sprite.blit(Sprite(glyph), x, y);
 		}
 	
 	private:
-		Sprite sprite;
-		Rectangle rectangle;
+		/**
+		 * Converts a row of distance samples to pixels.
+		 * The loop is branchless so that it can be vectorised by the compiler.
+		 */
+		void threshold(
+			const float* distances,
+			Uint32* pixels,
+			int width,
+			float scale,
+			float bias
+		) const noexcept {
+			float red = colour[0];
+			float green = colour[1];
+			float blue = colour[2];
+			
+			for (int i = 0; i < width; i++) {
+				float coverage = std::min(std::max(distances[i] * scale + bias, 0.0f), 1.0f);
+				pixels[i] =
+					static_cast<Uint32>(red * coverage) << 16
+					| static_cast<Uint32>(green * coverage) << 8
+					| static_cast<Uint32>(blue * coverage)
+				;
+			}
+		}
+		
+		/**
+		 * Prepares the glyph surface and sampling tables for the given size.
+		 * Nothing is allocated if the size is the same as the last character's.
+		 */
+		void prepare(int width, int height) const noexcept {
+			if (glyph && glyph->w == width && glyph->h == height) {
+				return;
+			}
+			
+			if (glyph) {
+				SDL_FreeSurface(glyph);
+			}
+			
+			// An opaque surface matches the glyph BMPs used by the other renderers.
+			glyph = SDL_CreateRGBSurface(0, width, height, 32, 0xff0000, 0x00ff00, 0x0000ff, 0);
+			
+			columns.resize(width);
+			column_weights.resize(width);
+			rows.resize(height);
+			row_weights.resize(height);
+			samples.resize(width);
+			
+			map(columns, column_weights, width);
+			map(rows, row_weights, height);
+		}
+		
+		/**
+		 * Maps each pixel of a rendering to the cell pixel before
+		 *   it and the weight of the cell pixel after it.
+		 */
+		void map(std::vector<int>& positions, std::vector<float>& weights, int length) const noexcept {
+			for (int i = 0; i < length; i++) {
+				float position = (i + 0.5f) * cell_size / length - 0.5f;
+				position = std::min(std::max(position, 0.0f), cell_size - 1.0f);
+				positions[i] = static_cast<int>(position);
+				weights[i] = position - positions[i];
+			}
+		}
+		
+		/**
+		 * Loads the distance values of the atlas at the given source.
+		 */
+		void load_atlas(const std::string& source) {
+			SDL_Surface* surface = SDL_LoadBMP(source.c_str());
+			
+			// An exception is thrown, if the atlas couldn't be loaded.
+			if (!surface) {
+				throw std::runtime_error(source + " could not be opened.");
+			}
+			
+			cell_size = surface->h;
+			
+			if (surface->w != N * cell_size) {
+				SDL_FreeSurface(surface);
+				throw std::runtime_error(source + " does not have a cell for each character.");
+			}
+			
+			// The atlas is converted to a known format, so that
+			//   atlases of any depth can be read.
+			SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGB888, 0);
+			SDL_FreeSurface(surface);
+			surface = converted;
+			
+			// An exception is thrown, if the atlas couldn't be converted.
+			if (!surface) {
+				throw std::runtime_error(source + " could not be converted.");
+			}
+			
+			// The red channel holds the distance.
+			atlas.resize(surface->w * surface->h);
+			SDL_LockSurface(surface);
+			
+			for (int j = 0; j < surface->h; j++) {
+				const Uint32* row = reinterpret_cast<const Uint32*>(
+					static_cast<const Uint8*>(surface->pixels) + j * surface->pitch
+				);
+				
+				for (int i = 0; i < surface->w; i++) {
+					atlas[j * surface->w + i] = row[i] >> 16 & 0xff;
+				}
+			}
+			
+			SDL_UnlockSurface(surface);
+			blended.resize(cell_size);
+			SDL_FreeSurface(surface);
+		}
+		
+		static constexpr int EDGE = 0x80; // The distance value of an edge.
+		
+		std::array<int, 256> indices;         // The cell of each character.
+		std::array<int, 3> colour;            // The colour of the characters.
+		std::vector<Uint8> atlas;             // The distance values of the atlas.
+		int cell_size;                        // The width and height of each cell.
+		mutable SDL_Surface* glyph = nullptr; // The surface that characters are rasterised to.
+		mutable std::vector<int> columns;     // The cell column of each glyph column.
+		mutable std::vector<float> column_weights; // The weight of the next cell column.
+		mutable std::vector<int> rows;        // The cell row of each glyph row.
+		mutable std::vector<float> row_weights; // The weight of the next cell row.
+		mutable std::vector<float> blended;   // A cell row blended between two atlas rows.
+		mutable std::vector<float> samples;   // A glyph row of distance samples.
 };
-//}
 
-// Renderer Classes
-//{
 /**
- * An abstract base class for renderer subclasses to inherit from.
- * All renderers should be able to render a single line from a string input.
+ * A class that displays a label followed by a non-negative integer.
+ * The label and the digits are rendered once on construction.
+ * Changing the value only redraws the digits that changed,
+ *   so the counter can be updated and blitted every frame
+ *   without rendering any text.
+ * Values that need more than the given number of digits are capped.
  */
-class Renderer {
+class Counter {
 	public:
-		/**
-		 * An enumeration for the justification in lined_render().
-		 */
-		enum Justification {
-			LEFT_JUSTIFY,
-			CENTRE_JUSTIFY,
-			RIGHT_JUSTIFY
-		};
+		// The maximum number of digits that a counter can display.
+		static constexpr int MAX_DIGITS = std::numeric_limits<int>::digits10;
 		
 		/**
-		 * Returns a sprite that is a single line rendering of the passed string.
+		 * Constructs a counter with the given label and number of digits.
 		 * The size (in pixels) of the characters must be specified.
+		 * The counter starts with the given value.
 		 */
-		virtual Sprite render(const std::string&, int, int, int) const noexcept = 0;
+		Counter(
+			const Renderer& renderer,
+			const std::string& label,
+			int digits,
+			int width,
+			int height,
+			int separation = 0,
+			int value = 0
+		) noexcept:
+			sprite(
+				(label.length() + clamp_digits(digits)) * (width + separation) - separation,
+				height
+			),
+			digits(clamp_digits(digits)),
+			offset(label.length() * (width + separation)),
+			step(width + separation)
+		{
+			// The label is rendered once.
+			sprite.clear();
+			sprite.blit(renderer.render(label, width, height, separation), 0, 0);
+			
+			// The glyph of each digit is rendered once.
+			for (int i = 0; i < System::NUMBERS; i++) {
+				glyphs[i] = renderer.render(std::string(1, '0' + i), width, height, separation);
+			}
+			
+			// All of the slots start blank.
+			for (int& slot: slots) {
+				slot = BLANK;
+			}
+			
+			set(value);
+		}
 		
 		/**
-		 * Returns a sprite that is a single line rendering of the passed string.
-		 * The size (in pixels) of the characters must be specified.
+		 * Constructs a counter with the given label and number of digits.
 		 * Uses ratios of the given sprite to determine the character size.
+		 * The counter starts with the given value.
 		 */
-		Sprite render(
+		Counter(
+			const Renderer& renderer,
 			const Sprite& ratio_base,
-			const std::string& text,
+			const std::string& label,
+			int digits,
 			double width,
 			double height,
-			double separation = 0
-		) const noexcept {
-			return render(
-				text,
+			double separation = 0,
+			int value = 0
+		) noexcept:
+			Counter(
+				renderer,
+				label,
+				digits,
 				width * ratio_base.width(),
 				height * ratio_base.height(),
-				separation * ratio_base.width()
-			);
-		}
+				separation * ratio_base.width(),
+				value
+			)
+		{}
 		
 		/**
-		 * Returns a sprite that is a multiple line rendering of the passed string.
-		 * The size (in pixels) of the characters must be specified.
-		 * The maximum width of the sprite and the space between lines can be defined.
-		 * The justification of the resulting sprite can be defined.
+		 * Sets the value displayed by the counter.
+		 * Only the digits that differ from the previous value are redrawn.
 		 */
-		Sprite lined_render(
-			const std::string& text,
-			int width,
-			int height,
-			int x_separation = 0,
-			int y_separation = 0,
-			int max_width = 0,
-			Justification justification = CENTRE_JUSTIFY
-		) const noexcept {
-			// If the text is empty an empty sprite is returned.
-			if (text != "") {
-				// A string stream is used to split the text.
-				// The string is appended with a new line to prevent
-				//   an infinite loop with std::getline().
-				std::stringstream stream(text + '\n');
-				// New lines always split the text rendering.
-				std::vector<std::string> text_lines;
-				// Placeholder string.
-				std::string string;
-				
-				// Each line is stored in the vector of text lines.
-				for (
-					std::getline(stream, string);
-					!stream.eof();
-					std::getline(stream, string)
-				) {
-					text_lines.push_back(string);
-				}
-				
-				// A vector of vectors of strings that represent each
-				//   line that should be separately be rendered.
-				std::vector<std::vector<std::string>> text_vectors;
-				// The minimum number of lines to be rendered.
-				int length = text_lines.size();
-				
-				// The vector of vectors of string is initialised.
-				for (int i = 0; i < length; i++) {
-					// A new vector is added.
-					text_vectors.push_back(std::vector<std::string>());
-					
-					// The string is appended with a space to prevent
-					//   an infinite loop with std::getline().
-					stream.clear();
-					stream.seekg(0);
-					stream.str(text_lines[i] + ' ');
-					
-					for (
-						std::getline(stream, string, ' ');
-						!stream.eof();
-						std::getline(stream, string, ' ')
-					) {
-						text_vectors[i].push_back(string);
-					}
-				}
-				
-				// The maximum number of characters in a line.
-				int max_characters = max_width / (width + x_separation);
-				
-				// The vector of vectors of strings is compressed.
-				// If multiple strings are small enough to fit on
-				//   one line, they are combined.
-				for (int i = 0; i < length; i++) {
-					for (int j = 0; j < text_vectors[i].size() - 1; j++) {
-						if (
-							!max_characters ||
-							1 + text_vectors[i][j].length()
-							+ text_vectors[i][j + 1].length()
-							<= max_characters
-						) {
-							text_vectors[i][j] += ' ' + text_vectors[i][j + 1];
-							text_vectors[i].erase(text_vectors[i].cbegin() + j + 1);
-							// The string is checked again.
-							j--;
-						}
-					}
-				}
-				
-				// The sprites for each lines are rendered.
-				std::vector<Sprite> sprites;
-				// The maximum length of the sprites.
-				int true_width = 0;
+		void set(int v) noexcept {
+			// The value is capped to what the digits can display.
+			int max = 0;
+			
+			for (int i = 0; i < digits; i++) {
+				max = 10 * max + 9;
+			}
+			
+			v = v < 0 ? 0 : v > max ? max : v;
+			
+			if (v == value) {
+				return;
+			}
+			
+			value = v;
+			
+			// The digits are found from least to most significant.
+			std::array<int, MAX_DIGITS> reversed;
+			int length = 0;
+			
+			do {
+				reversed[length++] = v % 10;
+				v /= 10;
+			} while (v);
+			
+			// The digits are placed from most to least significant
+			//   and the remaining slots are left blank.
+			for (int i = 0; i < digits; i++) {
+				int digit = i < length ? reversed[length - 1 - i] : BLANK;
 				
-				// The lines are rendered.
-				for (int i = 0; i < length; i++) {
-					int length2 = text_vectors[i].size();
+				if (slots[i] != digit) {
+					Rectangle slot(
+						offset + i * step,
+						0,
+						step,
+						sprite.get_height()
+					);
+					sprite.clear(slot);
 					
-					for (int j = 0; j < length2; j++) {
-						sprites.push_back(render(
-							text_vectors[i][j],
-							width,
-							height,
-							x_separation
-						));
-						int sprite_width = sprites.back().get_width();
-						
-						if (true_width < sprite_width) {
-							true_width = sprite_width;
-						}
-					}
-				}
-				
-				// The full sprite is initialised for blitting to.
-				length = sprites.size();
-				Sprite sprite(true_width, length * (height + y_separation) - y_separation);
-				
-				// The position of the sprites is determined by the justification.
-				int position;
-				
-				// The sprites are blitted onto a single sprite.
-				for (int i = 0; i < length; i++) {
-					// The position is found.
-					switch (justification) {
-						// Centre justify.
-						case CENTRE_JUSTIFY:
-							position = (true_width - sprites[i].get_width()) / 2;
-							break;
-							
-						// Left justify.
-						case LEFT_JUSTIFY:
-							position = 0;
-							break;
-							
-						// Right justify.
-						case RIGHT_JUSTIFY:
-							position = true_width - sprites[i].get_width();
-							break;
+					if (digit != BLANK) {
+						sprite.blit(glyphs[digit], slot);
 					}
 					
-					sprite.blit(sprites[i], position, i * (height + y_separation));
+					slots[i] = digit;
 				}
-				
-				return sprite;
 			}
-			
-			return Sprite();
 		}
 		
-		/**
-		 * Returns a sprite that is a multiple line rendering of the passed string.
-		 * The size (in pixels) of the characters must be specified.
-		 * The maximum width of the sprite and the space between lines can be defined.
-		 * The justification of the resulting sprite can be defined.
-		 * Uses ratios of the given sprite to determine the character size.
-		 */
-		Sprite lined_render(
-			const Sprite& ratio_base,
-			const std::string& text,
-			double width,
-			double height,
-			double x_separation = 0,
-			double y_separation = 0,
-			double max_width = 0,
-			Justification justification = CENTRE_JUSTIFY
-		) const noexcept {
-			return lined_render(
-				text,
-				width * ratio_base.width(),
-				height * ratio_base.height(),
-				x_separation * ratio_base.width(),
-				y_separation * ratio_base.height(),
-				max_width * ratio_base.width(),
-				justification
-			);
+		/**
+		 * Returns the value displayed by the counter.
+		 */
+		int get() const noexcept {
+			return value;
+		}
+		
+		/**
+		 * Blits the counter to the given sprite.
+		 * The top-left corner of the counter is blitted to the given coordinates.
+		 */
+		void blit_to(Sprite& s, int x = 0, int y = 0) const noexcept {
+			s.blit(sprite, x, y);
+		}
+		
+		/**
+		 * Returns a constant reference to the counter's sprite.
+		 */
+		const Sprite& get_sprite() const noexcept {
+			return sprite;
+		}
+	
+	private:
+		/**
+		 * Returns the number of digits limited to the range [1, MAX_DIGITS].
+		 */
+		static int clamp_digits(int digits) noexcept {
+			return digits < 1 ? 1 : digits > MAX_DIGITS ? MAX_DIGITS : digits;
 		}
+		
+		static constexpr int BLANK = -1; // The slot state for no digit.
+		
+		Sprite sprite;                                // The label and the digits.
+		std::array<Sprite, System::NUMBERS> glyphs;   // The sprite of each digit.
+		std::array<int, MAX_DIGITS> slots;            // The digit shown in each slot.
+		int digits;                                   // The number of digit slots.
+		int offset;                                   // The position of the first slot.
+		int step;                                     // The distance between slots.
+		int value = -1;                               // The value displayed.
 };
+//}
 
+// Particles
+//{
 /**
- * A class that manages the rendering of the sprites of
- *   characters and numbers to other sprites.
- * The characters and numbers are monospaced and only
- *   capital numbers are available.
+ * A class that manages a fixed number of particles, such as sparks or exhaust.
+ * Particles move in straight lines, fade as they age and are added
+ *   to the sprites they are blitted to, so overlapping particles glow.
+ * The particles are stored as a structure of arrays, so they are updated
+ *   by short loops over contiguous floats that can be vectorised.
+ * No memory is allocated after construction.
+ * Particles emitted while the pool is full, or past its limit, are dropped.
+ * Positions, sizes and speeds are in pixels and times are in seconds.
  */
-template<int N = System::RENDERER>
-class BasicRenderer: public Renderer {
+class Particles {
 	public:
 		/**
-		 * Constructs a new Renderer object.
-		 * Sprites are created for each letter and number
-		 *   that has a source passed.
-		 * The sources should be an array of strings and the count
-		 *   should be the number of strings passed.
-		 * The array of sources should start with the letters
-		 *   in alphabetical order and then the numbers in
-		 *   ascending order (A-Z then 0-9).
-		 * The Boolean, numbers_first, indicates that the numbers
-		 *   come before the letters in the array.
-		 * An empty string can be used to not load a specific character.
+		 * Constructs an empty pool for the given number of particles.
+		 * Each particle is a square of the given size and RGB colour.
+		 */
+		Particles(int capacity, int size, int red, int green, int blue) noexcept:
+			x(capacity),
+			y(capacity),
+			x_velocity(capacity),
+			y_velocity(capacity),
+			life(capacity),
+			inverse_lifetime(capacity),
+			brightness(capacity),
+			generator(Timer::current()),
+			capacity(capacity),
+			limit(capacity),
+			size(std::max(size, 1)),
+			colour({red, green, blue})
+		{}
+		
+		/**
+		 * Constructs an empty pool for the given number of particles.
+		 * Each particle is a square of the given size and predefined colour.
 		 */
-		BasicRenderer(
-			const std::array<std::string, N>& sources,
-			bool numbers_first = false
-		) noexcept {
-			load_sprites(sources, N, numbers_first);
-		}
-	
+		Particles(int capacity, int size, Sprite::Colour colour) noexcept:
+			Particles(
+				capacity,
+				size,
+				Sprite::to_rgb(colour)[0],
+				Sprite::to_rgb(colour)[1],
+				Sprite::to_rgb(colour)[2]
+			)
+		{}
+		
 		/**
-		 * Returns a sprite that is a rendering of the passed string.
-		 * The size (in pixels) of the characters must be specified.
-		 * The text is converted to uppercase.
+		 * Constructs an empty pool for the given number of particles.
+		 * The size of each particle is a ratio of the width of the given sprite.
 		 */
-		Sprite render(
-			const std::string& text,
-			int width,
-			int height,
-			int separation = 0
-		) const noexcept {
-			int length = text.length();
+		Particles(
+			int capacity,
+			const Sprite& ratio_base,
+			double size,
+			int red,
+			int green,
+			int blue
+		) noexcept:
+			Particles(capacity, size * ratio_base.width(), red, green, blue)
+		{}
+		
+		/**
+		 * Emits a burst of particles from the given point in every direction.
+		 * Each particle has a speed of up to the given speed and
+		 *   lives for between half of and the whole given lifetime.
+		 */
+		void emit(double px, double py, int number, double speed, double lifetime) noexcept {
+			number = std::max(std::min(number, limit - count), 0);
 			
-			if (length) {
-				Sprite rendering(length * (width + separation) - separation, height);
-				
-				for (int i = 0; i < length; i++) {
-					char character = text[i];
-					
-					// The character is converted to uppercase.
-					if ('a' <= character && character <= 'z') {
-						character -= 0x20;
-					}
-					
-					// A letter is rendered
-					if ('A' <= character && character <= 'Z') {
-						Sprite temporary(width, height);
-						temporary.blit(*letters[character - 'A']);
-						rendering.blit(temporary, i * (width + separation), 0);
-					}
-					
-					// A number is rendered
-					else if ('0' <= character && character <= '9') {
-						Sprite temporary(width, height);
-						temporary.blit(*numbers[character - '0']);
-						rendering.blit(temporary, i * (width + separation), 0);
-					}
-				}
-				
-				return rendering;
+			for (int i = count; i < count + number; i++) {
+				double angle = Random::get_real(generator, 0, FULL_TURN);
+				double s = Random::get_real(generator, 0, speed);
+				x[i] = px;
+				y[i] = py;
+				x_velocity[i] = s * std::cos(angle);
+				y_velocity[i] = s * std::sin(angle);
+				spawn(i, lifetime);
 			}
 			
-			return Sprite();
+			count += number;
 		}
 		
-	private:
 		/**
-		 * Constructs sprites for the given characters.
+		 * Emits a stream of particles from the given point with the given velocity.
+		 * Each component of each particle's velocity differs by up to the given spread.
+		 * Each particle lives for between half of and the whole given lifetime.
 		 */
-		void load_sprites(
-			const std::array<std::string, N>& sources,
-			int count,
-			bool numbers_first
+		void emit(
+			double px,
+			double py,
+			int number,
+			double vx,
+			double vy,
+			double spread,
+			double lifetime
 		) noexcept {
-			// Constructs the numbers first.
-			if (numbers_first) {
-				load_numbers(sources, 0, count);
-				load_letters(sources, System::NUMBERS, count - System::NUMBERS);
-			}
+			number = std::max(std::min(number, limit - count), 0);
 			
-			// Constructs the letters first.
-			else {
-				load_letters(sources, 0, count);
-				load_numbers(sources, System::LETTERS, count - System::LETTERS);
+			for (int i = count; i < count + number; i++) {
+				x[i] = px;
+				y[i] = py;
+				x_velocity[i] = vx + Random::get_real(generator, -spread, spread);
+				y_velocity[i] = vy + Random::get_real(generator, -spread, spread);
+				spawn(i, lifetime);
 			}
+			
+			count += number;
 		}
 		
 		/**
-		 * Constructs sprites for the given numbers.
+		 * Moves and ages the particles by the given time.
+		 * Particles that have reached the end of their lives are removed.
 		 */
-		void load_numbers(
-			const std::array<std::string, N>& sources,
-			int offset,
-			int count
-		) noexcept {
-			for (int i = 0; i < System::NUMBERS; i++) {
-				// The sprite is loaded if the source was given.
-				if (i < count && sources[i + offset] != "") {
-					numbers[i] = std::make_unique<Sprite>(sources[i + offset]);
+		void update(double elapsed) noexcept {
+			float t = elapsed;
+			float* px = x.data();
+			float* py = y.data();
+			const float* vx = x_velocity.data();
+			const float* vy = y_velocity.data();
+			float* l = life.data();
+			const float* inverse = inverse_lifetime.data();
+			float* b = brightness.data();
+			
+			// Each property is updated in its own loop, so each loop can be vectorised.
+			for (int i = 0; i < count; i++) {
+				px[i] += vx[i] * t;
+			}
+			
+			for (int i = 0; i < count; i++) {
+				py[i] += vy[i] * t;
+			}
+			
+			for (int i = 0; i < count; i++) {
+				l[i] -= t;
+			}
+			
+			for (int i = 0; i < count; i++) {
+				b[i] = l[i] * inverse[i];
+			}
+			
+			// Dead particles are replaced by the last particle.
+			for (int i = 0; i < count;) {
+				if (l[i] <= 0) {
+					remove(i);
 				}
 				
-				// Else, an empty sprite is loaded.
 				else {
-					numbers[i] = std::make_unique<Sprite>();
+					i++;
 				}
 			}
 		}
 		
 		/**
-		 * Constructs sprites for the given letters.
+		 * Adds the particles to the given sprite.
 		 */
-		void load_letters(
-			const std::array<std::string, N>& sources,
-			int offset,
-			int count
-		) noexcept {
-			for (int i = 0; i < System::LETTERS; i++) {
-				// The sprite is loaded if the source was given.
-				if (i < count && sources[i + offset] != "") {
-					letters[i] = std::make_unique<Sprite>(sources[i + offset]);
-				}
-				
-				// Else, an empty sprite is loaded.
-				else {
-					letters[i] = std::make_unique<Sprite>();
-				}
+		void blit_to(Sprite& sprite) const noexcept {
+			sprite.add_points(
+				x.data(),
+				y.data(),
+				brightness.data(),
+				count,
+				size,
+				colour[0],
+				colour[1],
+				colour[2]
+			);
+		}
+		
+		/**
+		 * Removes all of the particles.
+		 */
+		void clear() noexcept {
+			count = 0;
+		}
+		
+		/**
+		 * Returns the number of live particles.
+		 */
+		int get_count() const noexcept {
+			return count;
+		}
+		
+		/**
+		 * Returns the maximum number of live particles.
+		 */
+		int get_capacity() const noexcept {
+			return capacity;
+		}
+		
+		/**
+		 * Limits the number of live particles to fewer than the capacity.
+		 * Live particles past the limit are not removed,
+		 *   but no more are emitted until they die.
+		 */
+		void set_limit(int l) noexcept {
+			limit = std::max(std::min(l, capacity), 0);
+		}
+		
+		/**
+		 * Returns the limit on the number of live particles.
+		 */
+		int get_limit() const noexcept {
+			return limit;
+		}
+		
+		/**
+		 * Stretches the live particles' positions and velocities by the
+		 *   given ratios and sets the size of each particle.
+		 * Used to keep the particles in place when the sprite that
+		 *   they are blitted to is resized.
+		 */
+		void rescale(double x_ratio, double y_ratio, int s) noexcept {
+			float x_scale = x_ratio;
+			float y_scale = y_ratio;
+			
+			for (int i = 0; i < count; i++) {
+				x[i] *= x_scale;
+				x_velocity[i] *= x_scale;
+				y[i] *= y_scale;
+				y_velocity[i] *= y_scale;
 			}
+			
+			size = std::max(s, 1);
 		}
 		
-		std::array<std::unique_ptr<Sprite>, System::LETTERS> letters;
-		std::array<std::unique_ptr<Sprite>, System::NUMBERS> numbers;
+	private:
+		/**
+		 * Gives the particle at the given index a random lifetime of
+		 *   between half of and the whole given lifetime.
+		 */
+		void spawn(int i, double lifetime) noexcept {
+			life[i] = Random::get_double(generator, lifetime / 2, lifetime);
+			inverse_lifetime[i] = 1 / life[i];
+			brightness[i] = 1;
+		}
+		
+		/**
+		 * Replaces the particle at the given index with the last particle.
+		 */
+		void remove(int i) noexcept {
+			count--;
+			x[i] = x[count];
+			y[i] = y[count];
+			x_velocity[i] = x_velocity[count];
+			y_velocity[i] = y_velocity[count];
+			life[i] = life[count];
+			inverse_lifetime[i] = inverse_lifetime[count];
+			brightness[i] = brightness[count];
+		}
+		
+		static constexpr double FULL_TURN    // The angle of a full turn in radians.
+			= 6.283185307179586;
+		
+		std::vector<float> x;                // The x-coordinate of each particle.
+		std::vector<float> y;                // The y-coordinate of each particle.
+		std::vector<float> x_velocity;       // The x-velocity of each particle.
+		std::vector<float> y_velocity;       // The y-velocity of each particle.
+		std::vector<float> life;             // The time each particle has left.
+		std::vector<float> inverse_lifetime; // The reciprocal of each particle's lifetime.
+		std::vector<float> brightness;       // The fraction of each particle's lifetime left.
+		std::mt19937 generator;              // The particle RNG.
+		int count = 0;                       // The number of live particles.
+		int capacity;                        // The maximum number of live particles.
+		int limit;                           // The number of live particles allowed.
+		int size;                            // The width and height of each particle.
+		std::array<int, 3> colour;           // The RGB colour of the particles.
 };
 
 /**
- * A class that manages the rendering of the
- *   sprites of characters to other sprites.
- * Any character can be rendered and the
- *   rendering is defined by the user.
+ * A scrolling parallax background of a tiling strip under layers of stars.
+ * The strip scrolls down and wraps around, so it is blitted as two spans
+ *   of rows, which together cost the same as one blit of the strip.
+ * The spans are worked out when the field is updated, not when it is blitted.
+ * Each layer of stars is a randomly generated list of points that scrolls
+ *   at its own speed, so nearer layers, which should be faster, stand out.
+ * Stars are stored as ratios of the field's size, so the field can be resized
+ *   without generating them again, and are converted to pixels each frame
+ *   by short loops over contiguous floats that can be vectorised.
+ * Speeds are in field heights per second and times are in seconds.
  */
-template<int N>
-class FullRenderer: public Renderer {
+class Starfield {
 	public:
 		/**
-		 * Loads sprites for the given characters using the given sources.
+		 * Constructs a starfield of the given strip, scrolling at the given speed.
+		 * The field is the size of the strip.
 		 */
-		FullRenderer(
-			const std::array<char, N>& chars,
-			const std::array<std::string, N>& sources
+		Starfield(Sprite&& s, double speed) noexcept:
+			strip(std::move(s)),
+			speed(speed),
+			generator(Timer::current())
+		{}
+		
+		/**
+		 * Adds a layer of the given number of stars, scrolling at the given speed.
+		 * Each star is a square of the given size and RGB colour,
+		 *   dimmed to a random brightness of at least the given brightness.
+		 * Layers are blitted in the order they are added.
+		 */
+		void add_layer(
+			int count,
+			double speed,
+			int size,
+			int red,
+			int green,
+			int blue,
+			double least = 0.5
 		) noexcept {
-			for (int i = 0; i < N; i++) {
-				characters[i] = chars[i];
-				sprites[i] = std::make_unique<Sprite>(
-					sources[i]
-				);
+			layers.emplace_back();
+			Layer& layer = layers.back();
+			layer.x.resize(count);
+			layer.y.resize(count);
+			layer.brightness.resize(count);
+			layer.pixel_x.resize(count);
+			layer.pixel_y.resize(count);
+			layer.speed = speed;
+			layer.size = std::max(size, 1);
+			layer.colour = {red, green, blue};
+			
+			for (int i = 0; i < count; i++) {
+				layer.x[i] = Random::get_real(generator, 0, 1);
+				layer.y[i] = Random::get_real(generator, 0, 1);
+				layer.brightness[i] = Random::get_real(generator, least, 1);
 			}
 		}
 		
 		/**
-		 * Returns a sprite that is a rendering of the passed string.
-		 * The size (in pixels) of the characters must be specified.
-		 * Only characters that had a sprite loaded for them are rendered.
+		 * Adds a layer of the given number of stars, scrolling at the given speed.
+		 * Each star is a square of the given size and predefined colour.
 		 */
-		Sprite render(
-			const std::string& text,
-			int width,
-			int height,
-			int separation = 0
-		) const noexcept {
-			int length = text.length();
+		void add_layer(
+			int count,
+			double speed,
+			int size,
+			Sprite::Colour colour,
+			double least = 0.5
+		) noexcept {
+			std::array<int, 3> rgb = Sprite::to_rgb(colour);
+			add_layer(count, speed, size, rgb[0], rgb[1], rgb[2], least);
+		}
+		
+		/**
+		 * Scrolls the strip and the layers by the given time.
+		 */
+		void update(double elapsed) noexcept {
+			offset = wrap(offset + speed * elapsed);
 			
-			if (length) {
-				Sprite rendering(length * (width + separation) - separation, height);
+			for (Layer& layer: layers) {
+				layer.offset = wrap(layer.offset + layer.speed * elapsed);
+			}
+			
+			// The rows scrolled off the bottom of the field are wrapped to the top.
+			split = static_cast<int>(offset * strip.height()) % std::max(strip.height(), 1);
+		}
+		
+		/**
+		 * Blits the field to the given sprite, with its top-left corner at the given coordinates.
+		 */
+		void blit_to(Sprite& sprite, int x, int y) noexcept {
+			int width = strip.width();
+			int height = strip.height();
+			
+			// The strip is blitted as the span wrapped to the top and the span below it.
+			if (split > 0) {
+				sprite.blit(SpriteView(strip, Rectangle(0, height - split, width, split)), x, y);
+			}
+			
+			sprite.blit(SpriteView(strip, Rectangle(0, 0, width, height - split)), x, y + split);
+			
+			for (Layer& layer: layers) {
+				int count = layer.x.size();
+				const float* in_x = layer.x.data();
+				const float* in_y = layer.y.data();
+				float* out_x = layer.pixel_x.data();
+				float* out_y = layer.pixel_y.data();
+				float left = x;
+				float top = y;
+				float scale_x = width;
+				float scale_y = height;
+				float shift = layer.offset;
 				
-				for (int i = 0; i < length; i++) {
-					char character = text[i];
-					int index = -1;
-					
-					// The character is searched for.
-					for (int j = 0; j < N; j++) {
-						if (character == characters[j]) {
-							index = j;
-						}
-					}
-					
-					// The character is rendered, if it was found.
-					if (index >= 0) {
-						Sprite temporary(width, height);
-						temporary.blit(*sprites[index]);
-						rendering.blit(temporary, i * (width + separation), 0);
-					}
+				// Each coordinate is converted in its own loop, so each loop can be vectorised.
+				for (int i = 0; i < count; i++) {
+					out_x[i] = left + in_x[i] * scale_x;
 				}
 				
-				return rendering;
+				// Positions are never negative, so truncation wraps them like floor().
+				for (int i = 0; i < count; i++) {
+					float position = in_y[i] + shift;
+					out_y[i] = top + (position - static_cast<int>(position)) * scale_y;
+				}
+				
+				sprite.add_points(
+					out_x,
+					out_y,
+					layer.brightness.data(),
+					count,
+					layer.size,
+					layer.colour[0],
+					layer.colour[1],
+					layer.colour[2]
+				);
+			}
+		}
+		
+		/**
+		 * Blits the field to the given sprite, with its centre at the given position.
+		 * The position is a ratio of the size of the given sprite.
+		 */
+		void blit_to(Sprite& sprite, double x, double y) noexcept {
+			blit_to(
+				sprite,
+				static_cast<int>(sprite.width() * x - strip.width() / 2),
+				static_cast<int>(sprite.height() * y - strip.height() / 2)
+			);
+		}
+		
+		/**
+		 * Replaces the strip, such as after it is rescaled, and resizes the field to it.
+		 * The stars keep their places in the field, and their sizes
+		 *   are stretched by the change in the field's width.
+		 */
+		void set_strip(Sprite&& s) noexcept {
+			double ratio = strip.width() ? static_cast<double>(s.width()) / strip.width() : 1;
+			strip = std::move(s);
+			
+			for (Layer& layer: layers) {
+				layer.size = std::max(static_cast<int>(layer.size * ratio + 0.5), 1);
 			}
 			
-			return Sprite();
+			split = static_cast<int>(offset * strip.height()) % std::max(strip.height(), 1);
 		}
-	
+		
+		/**
+		 * Returns the width of the field.
+		 */
+		int width() const noexcept {
+			return strip.width();
+		}
+		
+		/**
+		 * Returns the height of the field.
+		 */
+		int height() const noexcept {
+			return strip.height();
+		}
+		
 	private:
-		std::array<char, N> characters;                 // The renderable characters.
-		std::array<std::unique_ptr<Sprite>, N> sprites; // The sprites for rendering.
+		/**
+		 * A layer of stars.
+		 */
+		struct Layer {
+			std::vector<float> x;          // The x-coordinate of each star, as a ratio of the width.
+			std::vector<float> y;          // The y-coordinate of each star, as a ratio of the height.
+			std::vector<float> brightness; // The brightness of each star.
+			std::vector<float> pixel_x;    // The x-coordinate of each star when last blitted.
+			std::vector<float> pixel_y;    // The y-coordinate of each star when last blitted.
+			double speed;                  // The speed the layer scrolls at.
+			double offset = 0;             // The distance the layer has scrolled.
+			int size;                      // The width and height of each star.
+			std::array<int, 3> colour;     // The RGB colour of the stars.
+		};
+		
+		/**
+		 * Returns the given distance wrapped to the height of the field.
+		 */
+		static double wrap(double distance) noexcept {
+			return distance - std::floor(distance);
+		}
+		
+		Sprite strip;              // The strip that tiles the field.
+		double speed;              // The speed the strip scrolls at.
+		double offset = 0;         // The distance the strip has scrolled.
+		int split = 0;             // The rows of the strip wrapped to the top of the field.
+		std::vector<Layer> layers; // The layers of stars, from the first blitted.
+		std::mt19937 generator;    // The star RNG.
 };
 //}
 
@@ -3164,6 +8118,62 @@ class BridgeThread: public Bridge {
 //}
 
 /* CHANGELOG:
+     v3.1:
+       Added the Counter class.
+       Added the SdfRenderer class and the sdfatlas tool for building its atlas.
+       Added the Sprite::clear() methods.
+       Renderer::lined_render() finds line breaks in a single pass and renders
+         each line directly to the returned sprite.
+       Added the Renderer::render_character() pure virtual method.
+       BasicRenderer::render() and FullRenderer::render() no longer
+         create a temporary sprite for each character.
+       Added a scaling Sprite::blit() overload for a given area.
+       Added the SpriteView and Atlas classes.
+       Added the Sprite::blit() overloads for SpriteView.
+       Added the Sprite::copy() method.
+       Added the Button constructors for SpriteView.
+       Added the Sprite::Format enum and Sprite::convert() methods for 16-bit and 8-bit sprites.
+       Sprite::clear() uses the colour key of keyed sprites.
+       Atlas pages can be stored in any sprite format.
+       Added the Sprite::set_key() and Sprite::encode_runs() methods.
+       Atlas pages are run-length encoded.
+       Added the Particles class.
+       Added the Sprite::add_points() method.
+       Added the Display::set_scale() method for rendering below the window's resolution.
+       Added Events::set_mouse_scale().
+       Added the Display::get_frame_time() and Display::get_present_time() hints.
+       Added the Particles::set_limit() method.
+       Added the Sprite::set_clip() and Sprite::reset_clip() methods.
+       Added the Display::set_asynchronous() method for presenting frames on a separate thread.
+       Added the Recorder class for capturing frames to disk.
+       Added the Sprite::get_pixel_format() and Sprite::read_pixels() methods.
+       The scaling Sprite constructors decode uncompressed 24-bit BMPs
+         straight to the sprite's size.
+       Added the SurfacePool class, which recycles the surfaces of destroyed sprites.
+       Added the Sprite::PixelView class for locked access to a sprite's pixels.
+       Added the Sprite::tint(), Sprite::fade(), Sprite::blend() and Sprite::threshold() effects.
+       Sprite::encode_runs() uses Sprite::threshold().
+       Added the Display::set_resizable() and Display::resized() methods.
+       Added the Layout class, which rescales sprites sized as ratios of
+         a resized sprite on worker threads.
+       Added the Particles::rescale() method.
+       Added the Display::set_backend() method for presenting frames through SDL_Renderer.
+       Added the Sprite::Mask class for pixel-accurate collision tests.
+       Added the SpriteCache class, Sprite::serialise() and Sprite::deserialise()
+         for caching rendered sprites between launches.
+       Added System::storage().
+       Added the Blitter class of compile-time specialised blit kernels,
+         which the unscaled Sprite::blit() overloads use when one matches.
+       Added the option to not run-length encode an Atlas's pages.
+       Added the Starfield class, a scrolling parallax background.
+       Recorder::export_frames() decodes a capture's segments in parallel.
+       Added Recorder::export_video() and Recorder::get_size().
+       Added Messenger::send_frame() and Messenger::read_frame(), which frame messages
+         with a varint length instead of padding them.
+       MessengerPackage reads a frame if its length is Messenger::FRAMED.
+       Added the MultiServer class, which services many clients from one thread with a socket set.
+       Added Messenger::append_length() and Messenger::parse_length().
+       Added Display::restore(), for drawing over the last frame of an asynchronous display.
      v3.0.2:
        Added a Sprite source-loaded, ratio constructor.
        Random::get_real() and Random::get_double() now take doubles instead of ints.
@@ -18,7 +18,7 @@
 // System Constants
 //{
 // The program's current version.
-constexpr int VERSION[System::VERSION_LENGTH] = {1, 1, 1, 0};
+constexpr int VERSION[System::VERSION_LENGTH] = {1, 2, 0, 0};
 
 // The total number of threads used for parallel computation.
 constexpr int THREADS = 4;
@@ -39,13 +39,43 @@ constexpr double ENEMY_ACCELERATION = 0.00125;
 
 // Video Constants
 //{
+// The fraction of the window's size that the game renders at.
+// Lower values trade sharpness for frame rate.
+constexpr double RENDER_SCALE = 1;
+
+// How frames are presented.
+// The display's present times for each backend show which is faster on a device.
+constexpr Display::Backend PRESENT_BACKEND = Display::WINDOW_SURFACE;
+
+// True if frames are presented on a separate thread on Windows.
+// Frames are never presented asynchronously through a renderer, or on other platforms,
+//   whose window surfaces are backed by a renderer that belongs to the main thread.
+constexpr bool ASYNCHRONOUS_PRESENT = false;
+
+// True if the window can be resized, or rotated, while the game runs.
+constexpr bool RESIZABLE_WINDOW = true;
+
+// The file that gameplay frames are captured to, or empty to capture nothing.
+// Captures are turned into BMP sequences or raw video by the capturevideo tool.
+constexpr const char* CAPTURE_DESTINATION = "";
+
+// The organisation and application whose storage the menu's cache is kept in.
+// The cache is rebuilt when the display's size, the version or the menu's assets change.
+// An empty cache name renders the menu at every launch.
+constexpr const char* CACHE_ORGANISATION = "Chigozie Agomo";
+constexpr const char* CACHE_APPLICATION = "Space Defence Mobile";
+constexpr const char* MENU_CACHE_NAME = "menu.cache";
+
 // Renderer Constants
 //{
-// The renderer's asset folder.
-constexpr const char* RENDERER_DIRECTORY = "data/";
+// The renderer's distance field atlas.
+// Built from the glyph BMPs in the order of the renderer's characters:
+//   sdfatlas data/font.bmp 48 data/[a-z].bmp data/[a-z].bmp data/[0-9].bmp
+//     data/fullstop.bmp data/comma.bmp data/exclamation.bmp data/colon.bmp
+constexpr const char* RENDERER_SOURCE = "data/font.bmp";
 
-// The extension of the renderer's assets.
-constexpr const char* RENDERER_EXTENSION = ".bmp";
+// The colour of the rendered characters.
+constexpr Sprite::Colour RENDERER_COLOUR = Sprite::CYAN;
 
 // The numbers of letters used by the renderer.
 constexpr int RENDERER_LETTERS = 26;
@@ -56,10 +86,10 @@ constexpr int RENDERER_CASES = 2;
 // The number of numbers used by the renderer.
 constexpr int RENDERER_NUMBERS = 10;
 
-// The first index of the extra characters and sources.
+// The first index of the extra characters.
 constexpr int RENDERER_EXTRA_INDEX = RENDERER_CASES * RENDERER_LETTERS + RENDERER_NUMBERS;
 
-// The number of extra characters and sources.
+// The number of extra characters.
 constexpr int RENDERER_EXTRAS = 4;
 
 // The extra characters used by the renderer.
@@ -70,18 +100,14 @@ constexpr char RENDERER_EXTRA_CHARACTERS[RENDERER_EXTRAS] = {
     ':'
 };
 
-// The extra sources used by the renderer.
-constexpr const char* RENDERER_EXTRA_SOURCES[RENDERER_EXTRAS] = {
-    "fullstop",
-    "comma",
-    "exclamation",
-    "colon"
-};
-
-// The total number of characters-source pairings for the renderer.
+// The total number of characters for the renderer.
 constexpr int RENDERER_COUNT = RENDERER_EXTRA_INDEX + RENDERER_EXTRAS;
 //}
 
+// True if the gameplay sprites are blitted by kernels specialised for their
+//   format and width, instead of being run-length encoded and blitted by SDL.
+constexpr bool SPECIALISED_BLITS = true;
+
 // Background Constants
 //{
 // Main Menu Background.
@@ -94,6 +120,22 @@ constexpr double GAME_BACKGROUND_WIDTH = 1;
 constexpr double GAME_BACKGROUND_HEIGHT = 0.9;
 constexpr double GAME_BACKGROUND_X = 0.5;
 constexpr double GAME_BACKGROUND_Y = 1 - GAME_BACKGROUND_HEIGHT / 2;
+
+// The speed the background scrolls at, in background heights per second.
+constexpr double GAME_BACKGROUND_SPEED = 0.02;
+
+// The longest time the background scrolls by in one frame, so it doesn't jump after a pause.
+constexpr double GAME_BACKGROUND_MAX_STEP = 0.1;
+//}
+
+// Star Constants
+//{
+// The layers of stars scrolling over the game background, from the farthest to the nearest.
+constexpr int STAR_LAYERS = 3;
+constexpr int STAR_COUNTS[STAR_LAYERS] = {120, 60, 20};
+constexpr double STAR_SPEEDS[STAR_LAYERS] = {0.04, 0.08, 0.16};
+constexpr double STAR_SIZES[STAR_LAYERS] = {0.003, 0.005, 0.008};
+constexpr Sprite::Colour STAR_COLOUR = Sprite::WHITE;
 //}
 //}
 
@@ -207,11 +249,17 @@ constexpr double PLAY_BUTTON_X = RESET_BUTTON_X - BUTTON_WIDTH;
 //{
 constexpr const char* PAUSE_BUTTON_SOURCE = "data/pause.bmp";
 constexpr double PAUSE_BUTTON_X = PLAY_BUTTON_X;
+
+// The amount that the display is darkened by while the game is paused.
+constexpr double PAUSE_FADE = 0.5;
 //}
 //}
 
 // Class Constants
 //{
+// The background colour of the ship BMPs, which is made transparent.
+constexpr Sprite::Colour SHIP_KEY = Sprite::BLACK;
+
 // Player Constants
 //{
 constexpr const char* PLAYER_SOURCE = "data/player.bmp";
@@ -230,7 +278,8 @@ constexpr double SHOT_HEIGHT = PLAYER_HEIGHT;
 
 // Score Constants
 //{
-#define SCORE_STRING ("Score: " + std::to_string(score))
+constexpr const char* SCORE_LABEL = "Score: ";
+constexpr int SCORE_DIGITS = 6;
 constexpr int SCORE_X = 0;
 constexpr int SCORE_Y = 0;
 constexpr double SCORE_HEIGHT = BUTTON_HEIGHT;
@@ -247,6 +296,67 @@ constexpr double ENEMY_Y = BUTTON_HEIGHT - ENEMY_HEIGHT / 2;
 constexpr double ENEMY_MIN = ENEMY_WIDTH / 2;
 constexpr double ENEMY_MAX = 1 - ENEMY_MIN;
 //}
+
+// Governor Constants
+//{
+// The frame rate that the governor aims for.
+constexpr double TARGET_RATE = 60;
+
+// The weight of each frame time in the governor's moving average.
+constexpr double GOVERNOR_SMOOTHING = 0.1;
+
+// Quality is shed when the average frame time exceeds this ratio of the budget.
+constexpr double GOVERNOR_SHED = 1.1;
+
+// Quality is restored when the average frame time is below this ratio of the budget.
+constexpr double GOVERNOR_RESTORE = 0.7;
+
+// The time (in seconds) after a change before quality can be shed or restored.
+constexpr double GOVERNOR_SHED_DELAY = 0.5;
+constexpr double GOVERNOR_RESTORE_DELAY = 2;
+
+// The ratios of the particle capacities used when particles are shed.
+constexpr double FEWER_PARTICLES_RATIO = 0.5;
+constexpr double FEWEST_PARTICLES_RATIO = 0.15;
+
+// The number of frames per HUD redraw when the HUD is shed.
+constexpr int SLOWER_HUD_INTERVAL = 4;
+
+// The ratio of RENDER_SCALE used when the scale is shed.
+constexpr double LOWER_SCALE_RATIO = 0.5;
+//}
+
+// Particle Constants
+//{
+// The size of a particle, as a ratio of the display's width.
+constexpr double PARTICLE_SIZE = 0.004;
+
+// Explosion Constants
+// The speed is a ratio of the display's width per second.
+//{
+constexpr int EXPLOSION_CAPACITY = 40000;
+constexpr int EXPLOSION_PARTICLES = 600;
+constexpr double EXPLOSION_SPEED = 0.4;
+constexpr double EXPLOSION_LIFETIME = 0.8;
+constexpr int EXPLOSION_RED = 0xff;
+constexpr int EXPLOSION_GREEN = 0x90;
+constexpr int EXPLOSION_BLUE = 0x30;
+//}
+
+// Exhaust Constants
+// The rate is in particles per enemy per second.
+// The velocity and spread are ratios of the display's height per second.
+//{
+constexpr int EXHAUST_CAPACITY = 10000;
+constexpr double EXHAUST_RATE = 120;
+constexpr double EXHAUST_VELOCITY = -0.15;
+constexpr double EXHAUST_SPREAD = 0.03;
+constexpr double EXHAUST_LIFETIME = 0.4;
+constexpr int EXHAUST_RED = 0x30;
+constexpr int EXHAUST_GREEN = 0x60;
+constexpr int EXHAUST_BLUE = 0xff;
+//}
+//}
 //}
 //}
 
@@ -268,7 +378,7 @@ class Enemy {
         /**
          * An enemy has a reference to its sprite and is reset.
          */
-        Enemy(const Sprite& sprite, double position, double velocity) noexcept:
+        Enemy(const SpriteView& sprite, double position, double velocity) noexcept:
             sprite(&sprite),
             position({position, ENEMY_Y}),
             velocity(velocity)
@@ -303,7 +413,7 @@ class Enemy {
         }
         
     private:
-        const Sprite* sprite; // A reference to the enemy sprite.
+        const SpriteView* sprite; // A reference to the enemy sprite.
         std::array<double, 2> position; // The enemy's coordinates.
         double velocity; // The enemy's velocity.
 };
@@ -315,10 +425,11 @@ class Enemy {
 class Shot {
     public:
         /**
-         * Loads the shot's assets and reset it.
+         * Takes the shot's sprite and collision mask and resets it.
          */
-        Shot(const Sprite& display) noexcept:
-            sprite(SHOT_SOURCE, display, SHOT_WIDTH, SHOT_HEIGHT)
+        Shot(const SpriteView& sprite, const Sprite::Mask& mask) noexcept:
+            sprite(sprite),
+            mask(mask)
         {
             reset();
         }
@@ -386,6 +497,21 @@ class Shot {
             last_move += elapsed;
         }
         
+        /**
+         * Replaces the shot's sprite and mask, such as after they are rescaled.
+         */
+        void set_sprite(const SpriteView& s, const Sprite::Mask& m) noexcept {
+            sprite = s;
+            mask = m;
+        }
+        
+        /**
+         * Returns the shot's collision mask.
+         */
+        const Sprite::Mask& get_mask() const noexcept {
+            return mask;
+        }
+        
         /**
          * Returns the shot's x-coordinate.
          */
@@ -401,7 +527,8 @@ class Shot {
         }
         
     private:
-        Sprite sprite; // The shot's sprite.
+        SpriteView sprite; // The shot's sprite.
+        Sprite::Mask mask; // The shot's collision mask.
         std::array<double, 2> position; // The shot's coordinates.
         bool active; // True when the shot is being fired.
         double last_move; // The time when the shot was moved last.
@@ -451,35 +578,96 @@ class EnemyPackage {
 /**
  * A container class for the enemies.
  * Manages all of the enemies and their shared resources.
+ * Enemies trail exhaust and explode when they are shot.
  */
 class Enemies {
     public:
         /**
-         * Loads the enemy sprite and resets the enemy container.
+         * Takes the enemy sprite and collision mask and resets the enemy container.
+         * The particles are sized and moved in proportion to the display.
          */
-        Enemies(const Sprite& display) noexcept:
-            sprite(ENEMY_SOURCE, display, ENEMY_WIDTH, ENEMY_HEIGHT),
-            generator(Timer::current())
+        Enemies(const Sprite& display, const SpriteView& sprite, const Sprite::Mask& mask) noexcept:
+            sprite(sprite),
+            mask(mask),
+            generator(Timer::current()),
+            explosions(
+                EXPLOSION_CAPACITY,
+                display,
+                PARTICLE_SIZE,
+                EXPLOSION_RED,
+                EXPLOSION_GREEN,
+                EXPLOSION_BLUE
+            ),
+            exhaust(
+                EXHAUST_CAPACITY,
+                display,
+                PARTICLE_SIZE,
+                EXHAUST_RED,
+                EXHAUST_GREEN,
+                EXHAUST_BLUE
+            ),
+            display_size({
+                static_cast<double>(display.width()),
+                static_cast<double>(display.height())
+            })
         {
             reset();
         }
         
         /**
-         * Removes all of the enemies and resets the last move and next spawn time.
+         * Removes all of the enemies and their particles.
+         * Resets the last move and next spawn time.
          */
         void reset() noexcept {
             enemies.clear();
+            explosions.clear();
+            exhaust.clear();
+            exhaust_due = 0;
             last_move = Timer::time();
             next_spawn = last_move + ENEMY_DELAY;
         }
         
         /**
-         * Blits all of the enemies to the display.
+         * Blits the enemies and their particles to the display.
+         * Exhaust is blitted behind the enemies and explosions in front of them.
+         * Enemies entirely outside of the viewport are culled instead of blitted.
          */
-        void blit_to(Sprite& display) const noexcept {
+        void blit_to(Sprite& display, const Rectangle& viewport) noexcept {
+            exhaust.blit_to(display);
+            
+            // Each enemy's bounds are tested against the viewport.
+            Rectangle bounds(0, 0, sprite.width(), sprite.height());
+            drawn = 0;
+            culled = 0;
+            
             for (const Enemy& enemy: enemies) {
-                enemy.blit_to(display);
+                bounds.set(display.width(), display.height(), enemy.get_x(), enemy.get_y());
+                
+                if (viewport.intersects(bounds)) {
+                    enemy.blit_to(display);
+                    ++drawn;
+                }
+                
+                else {
+                    ++culled;
+                }
             }
+            
+            explosions.blit_to(display);
+        }
+        
+        /**
+         * Returns the number of enemies blitted by the last blit.
+         */
+        int get_drawn() const noexcept {
+            return drawn;
+        }
+        
+        /**
+         * Returns the number of enemies culled by the last blit.
+         */
+        int get_culled() const noexcept {
+            return culled;
         }
         
         /**
@@ -510,6 +698,25 @@ class Enemies {
             thread2.wait();
             thread3.wait();
             
+            // The particles are moved and each enemy emits its share of exhaust.
+            explosions.update(elapsed);
+            exhaust.update(elapsed);
+            exhaust_due += EXHAUST_RATE * elapsed;
+            int exhaust_count = exhaust_due;
+            exhaust_due -= exhaust_count;
+            
+            for (const Enemy& enemy: enemies) {
+                exhaust.emit(
+                    enemy.get_x() * display_size[0],
+                    (enemy.get_y() - ENEMY_HEIGHT / 2) * display_size[1],
+                    exhaust_count,
+                    0,
+                    EXHAUST_VELOCITY * display_size[1],
+                    EXHAUST_SPREAD * display_size[1],
+                    EXHAUST_LIFETIME
+                );
+            }
+            
             // A new enemy is spawned if enough time has passed.
             if (now >= next_spawn) {
                 enemies.push_front(
@@ -525,6 +732,14 @@ class Enemies {
             }
         }
         
+        /**
+         * Limits the particles to the given ratio of their capacities.
+         */
+        void set_particle_ratio(double ratio) noexcept {
+            explosions.set_limit(ratio * EXPLOSION_CAPACITY);
+            exhaust.set_limit(ratio * EXHAUST_CAPACITY);
+        }
+        
         /**
          * Increases the value of last_move and next_spawn by the given value.
          */
@@ -533,9 +748,32 @@ class Enemies {
             next_spawn += elapsed;
         }
         
+        /**
+         * Replaces the sprite and mask of all of the enemies, such as after they are rescaled.
+         */
+        void set_sprite(const SpriteView& s, const Sprite::Mask& m) noexcept {
+            sprite = s;
+            mask = m;
+        }
+        
+        /**
+         * Keeps the particles in place on the resized display.
+         */
+        void resize(const Sprite& display) noexcept {
+            double x_ratio = display.width() / display_size[0];
+            double y_ratio = display.height() / display_size[1];
+            explosions.rescale(x_ratio, y_ratio, PARTICLE_SIZE * display.width());
+            exhaust.rescale(x_ratio, y_ratio, PARTICLE_SIZE * display.width());
+            display_size = {
+                static_cast<double>(display.width()),
+                static_cast<double>(display.height())
+            };
+        }
+        
         /**
          * Checks if the shot made contact with an enemy.
-         * If it did, the enemy is removed and true is returned.
+         * The boxes are compared first and then, if they overlap, the masks.
+         * If it did, the enemy explodes and is removed and true is returned.
          */
         bool contact(const Shot& shot) noexcept {
             for (
@@ -548,7 +786,15 @@ class Enemies {
                     <= (SHOT_WIDTH + ENEMY_WIDTH) / 2
                     && std::abs(shot.get_y() - i->get_y())
                     <= (SHOT_HEIGHT + ENEMY_HEIGHT) / 2
+                    && overlap(i->get_x(), i->get_y(), shot.get_mask(), shot.get_x(), shot.get_y())
                 ) {
+                    explosions.emit(
+                        i->get_x() * display_size[0],
+                        i->get_y() * display_size[1],
+                        EXPLOSION_PARTICLES,
+                        EXPLOSION_SPEED * display_size[0],
+                        EXPLOSION_LIFETIME
+                    );
                     enemies.erase(std::next(i).base());
                     return true;
                 }
@@ -559,16 +805,20 @@ class Enemies {
         
         /**
          * Returns true if one of the enemies has reached the end.
-         * Returns true if one of the enemies has come into contact with the player.
+         * Returns true if one of the enemies has come into contact with the player,
+         *   whose mask is given, after comparing their boxes and then their masks.
          * Returns false otherwise.
          */
-        bool victory(double position) const noexcept {
+        bool victory(double position, const Sprite::Mask& player_mask) const noexcept {
             const Enemy& enemy = enemies.back();
             
             return
                 enemy.get_y() >= 1 - ENEMY_HEIGHT / 2
-                || enemy.get_y() >= PLAYER_Y - (PLAYER_HEIGHT + ENEMY_HEIGHT) / 2
-                && std::abs(enemy.get_x() - position) <= (PLAYER_WIDTH + ENEMY_WIDTH) / 2
+                || (
+                    enemy.get_y() >= PLAYER_Y - (PLAYER_HEIGHT + ENEMY_HEIGHT) / 2
+                    && std::abs(enemy.get_x() - position) <= (PLAYER_WIDTH + ENEMY_WIDTH) / 2
+                    && overlap(enemy.get_x(), enemy.get_y(), player_mask, position, PLAYER_Y)
+                )
             ;
         }
         
@@ -597,6 +847,20 @@ class Enemies {
         }
         
     private:
+        /**
+         * Returns true if the mask of an enemy at the given position overlaps
+         *   the given mask at the given position.
+         * The masks are placed in pixels in the same way as their sprites are blitted.
+         */
+        bool overlap(double x, double y, const Sprite::Mask& other, double other_x, double other_y) const noexcept {
+            int left = static_cast<int>(display_size[0] * x - mask.width() / 2);
+            int top = static_cast<int>(display_size[1] * y - mask.height() / 2);
+            int other_left = static_cast<int>(display_size[0] * other_x - other.width() / 2);
+            int other_top = static_cast<int>(display_size[1] * other_y - other.height() / 2);
+            
+            return mask.overlaps(other, other_left - left, other_top - top);
+        }
+        
         /**
          * Randomy generates an onscreen position for a new enemy.
          */
@@ -604,11 +868,136 @@ class Enemies {
             return Random::get_double(generator, ENEMY_MIN, ENEMY_MAX);
         }
         
-        Sprite sprite; // The sprite of all of the enemies.
+        SpriteView sprite; // The sprite of all of the enemies.
+        Sprite::Mask mask; // The collision mask of all of the enemies.
         std::mt19937 generator; // The enemy RNG.
         std::list<Enemy> enemies; // The enemy store.
+        Particles explosions; // The particles of destroyed enemies.
+        Particles exhaust; // The particles trailing the enemies.
+        std::array<double, 2> display_size; // The display's dimensions, for the particles.
+        double exhaust_due; // The fraction of an exhaust particle due per enemy.
         double last_move; // The last time when the enemies were moved.
         double next_spawn; // The last time when an enemy was spawned.
+        int drawn = 0; // The number of enemies blitted by the last blit.
+        int culled = 0; // The number of enemies culled by the last blit.
+};
+
+/**
+ * A class that trades optional work for frame rate.
+ * The governor keeps a moving average of the frame time and sheds one
+ *   level of quality at a time while frames run over budget, then
+ *   restores one level at a time once there is headroom again.
+ * Levels only change after a delay, so that a single slow
+ *   frame is ignored and the levels do not oscillate.
+ */
+class Governor {
+    public:
+        /**
+         * The quality levels, from the highest to the lowest.
+         * Each level also sheds the work of the levels above it.
+         */
+        enum Level {
+            FULL,            // Nothing is shed.
+            FEWER_PARTICLES, // Fewer particles are emitted.
+            SLOWER_HUD,      // The HUD is redrawn less often.
+            NO_BACKGROUND,   // The background is filled instead of blitted and even fewer particles are emitted.
+            LOWER_SCALE      // The next game renders at a lower scale.
+        };
+        
+        /**
+         * Constructs a governor for the given frame time budget, in seconds.
+         */
+        Governor(double budget) noexcept:
+            budget(budget),
+            average(budget)
+        {}
+        
+        /**
+         * Adds a frame time to the average and changes the level if needed.
+         */
+        void update(double frame_time) noexcept {
+            if (skipping || frame_time <= 0) {
+                skipping = false;
+                return;
+            }
+            
+            average += (frame_time - average) * GOVERNOR_SMOOTHING;
+            since_change += frame_time;
+            
+            if (
+                average > budget * GOVERNOR_SHED
+                && since_change >= GOVERNOR_SHED_DELAY
+                && level < LOWER_SCALE
+            ) {
+                level = static_cast<Level>(level + 1);
+                since_change = 0;
+            }
+            
+            else if (
+                average < budget * GOVERNOR_RESTORE
+                && since_change >= GOVERNOR_RESTORE_DELAY
+                && level > FULL
+            ) {
+                level = static_cast<Level>(level - 1);
+                since_change = 0;
+            }
+        }
+        
+        /**
+         * Ignores the next frame time.
+         * Used for frames that include waiting, such as being paused.
+         */
+        void skip() noexcept {
+            skipping = true;
+        }
+        
+        /**
+         * Returns the current quality level.
+         */
+        Level get_level() const noexcept {
+            return level;
+        }
+        
+        /**
+         * Returns the ratio of the particle capacities to use.
+         */
+        double get_particle_ratio() const noexcept {
+            return
+                level >= NO_BACKGROUND ? FEWEST_PARTICLES_RATIO
+                : level >= FEWER_PARTICLES ? FEWER_PARTICLES_RATIO
+                : 1
+            ;
+        }
+        
+        /**
+         * Returns the number of frames per HUD redraw.
+         */
+        int get_hud_interval() const noexcept {
+            return level >= SLOWER_HUD ? SLOWER_HUD_INTERVAL : 1;
+        }
+        
+        /**
+         * Returns true if the background should be blitted.
+         */
+        bool get_background() const noexcept {
+            return level < NO_BACKGROUND;
+        }
+        
+        /**
+         * Returns the scale that a game should render at.
+         * The scale can only change between games,
+         *   since the sprites are sized when a game starts.
+         */
+        double get_scale() const noexcept {
+            return level >= LOWER_SCALE ? RENDER_SCALE * LOWER_SCALE_RATIO : RENDER_SCALE;
+        }
+        
+    private:
+        double budget; // The target frame time.
+        double average; // The moving average of the frame time.
+        double since_change = 0; // The frame time accumulated since the level changed.
+        Level level = FULL; // The current quality level.
+        bool skipping = false; // True if the next frame time is ignored.
 };
 
 /**
@@ -619,12 +1008,30 @@ class Player {
     public:
         /**
          * Constructs a player.
-         * The assets for the player are loaded.
+         * The player and its shot take their sprites and collision masks.
+         * The player's score counter is rendered.
          * The player is then reset.
          */
-        Player(const Sprite& display) noexcept:
-            shot(display),
-            sprite(PLAYER_SOURCE, display, PLAYER_WIDTH, PLAYER_HEIGHT)
+        Player(
+            const Sprite& display,
+            const Renderer& renderer,
+            const SpriteView& sprite,
+            const SpriteView& shot_sprite,
+            const Sprite::Mask& mask,
+            const Sprite::Mask& shot_mask
+        ) noexcept:
+            sprite(sprite),
+            mask(mask),
+            shot(shot_sprite, shot_mask),
+            counter(
+                renderer,
+                display,
+                SCORE_LABEL,
+                SCORE_DIGITS,
+                SCORE_WIDTH,
+                SCORE_HEIGHT,
+                SCORE_SEPARATION
+            )
         {
             reset();
         }
@@ -638,6 +1045,7 @@ class Player {
             destination = position;
             last_move = Timer::time();
             score = 0;
+            counter.set(score);
         }
         
         /**
@@ -648,24 +1056,17 @@ class Player {
         }
         
         /**
-         * Renders the player and the player's score.
+         * Blits the player to the display.
          */
-        void blit_to(Sprite& display, const Renderer& renderer) const noexcept {
-            // The player is blit to the display first.
+        void blit_to(Sprite& display) const noexcept {
             display.blit(sprite, position, PLAYER_Y);
-            
-            // The score is blit to the display last.
-            display.blit(
-                renderer.render(
-                    display,
-                    SCORE_STRING,
-                    SCORE_WIDTH,
-                    SCORE_HEIGHT,
-                    SCORE_SEPARATION
-                ),
-                SCORE_X,
-                SCORE_Y
-            );
+        }
+        
+        /**
+         * Blits the player's score to the display.
+         */
+        void blit_score(Sprite& display) const noexcept {
+            counter.blit_to(display, SCORE_X, SCORE_Y);
         }
         
         /**
@@ -678,11 +1079,11 @@ class Player {
             if (enemies.contact(shot)) {
                 // If an enemy was shot, the score is incremented and the shot is reset.
                 shot.reset();
-                ++score;
+                counter.set(++score);
             }
             
             // Then, enemy victory is checked.
-            if (enemies.victory(position)) {
+            if (enemies.victory(position, mask)) {
                 return true;
             }
             
@@ -770,6 +1171,36 @@ class Player {
             last_move += elapsed;
         }
         
+        /**
+         * Replaces the player's and shot's sprites and masks, such as after they are rescaled.
+         */
+        void set_sprites(
+            const SpriteView& s,
+            const SpriteView& shot_sprite,
+            const Sprite::Mask& m,
+            const Sprite::Mask& shot_mask
+        ) noexcept {
+            sprite = s;
+            mask = m;
+            shot.set_sprite(shot_sprite, shot_mask);
+        }
+        
+        /**
+         * Renders the score counter again for the resized display.
+         */
+        void resize(const Sprite& display, const Renderer& renderer) noexcept {
+            counter = Counter(
+                renderer,
+                display,
+                SCORE_LABEL,
+                SCORE_DIGITS,
+                SCORE_WIDTH,
+                SCORE_HEIGHT,
+                SCORE_SEPARATION
+            );
+            counter.set(score);
+        }
+        
         /**
          * Returns the score.
          */
@@ -778,29 +1209,79 @@ class Player {
         }
         
     private:
-        Sprite sprite; // The player's sprite.
+        SpriteView sprite; // The player's sprite.
+        Sprite::Mask mask; // The player's collision mask.
         Shot shot; // The player's shot.
         double position; // The player's x-coordinate.
         double destination; // The player's destination.
         double last_move; // The time when the player last moved.
         int score; // The player's score.
+        Counter counter; // The player's score display.
 };
 //}
 
 // Main Functions
 //{
+/**
+ * Returns an atlas of copies of the layout's first given number of sprites.
+ * Each sprite's view has the same index in the atlas as in the layout.
+ * The sprites are stored in high colour only on a high colour display,
+ *   so that they are blitted without converting each pixel.
+ */
+Atlas pack_sprites(const Layout& layout, int count, const Sprite& display) noexcept {
+    Sprite::Format format = display.get_format() == Sprite::HIGH_COLOUR ? Sprite::HIGH_COLOUR : Sprite::TRUE_COLOUR;
+    Atlas atlas(display.width(), display.height(), format, !SPECIALISED_BLITS);
+    
+    for (int i = 0; i < count; ++i) {
+        atlas.add(Sprite(layout.get(i)));
+    }
+    
+    atlas.pack();
+    
+    return atlas;
+}
+
 /**
  * Manages the main game.
+ * The governor's quality level is kept between games.
+ * Each frame of play is passed to the recorder before it is presented.
  */
-void game(Display& display, const Renderer& renderer) noexcept {
-    // The background is initialised.
-    Sprite background(
-        GAME_BACKGROUND_SOURCE,
-        display,
+void game(Display& display, const Renderer& renderer, Governor& governor, Recorder& recorder) noexcept {
+    // The display is scaled for the governor, before any sprites are sized.
+    display.set_scale(governor.get_scale());
+    governor.skip();
+    
+    // The sprites are sized as ratios of the display and kept with their
+    //   sources in a layout, so they can be rescaled when the window is resized.
+    // The gameplay sprites are added first, to be packed into an atlas.
+    Layout layout(display);
+    int play_sprite = layout.add(Sprite(PLAY_BUTTON_SOURCE), BUTTON_WIDTH, BUTTON_HEIGHT);
+    int pause_sprite = layout.add(Sprite(PAUSE_BUTTON_SOURCE), BUTTON_WIDTH, BUTTON_HEIGHT);
+    int reset_sprite = layout.add(Sprite(RESET_BUTTON_SOURCE), BUTTON_WIDTH, BUTTON_HEIGHT);
+    int quit_sprite = layout.add(Sprite(QUIT_BUTTON_SOURCE), BUTTON_WIDTH, BUTTON_HEIGHT);
+    int player_sprite = layout.add(Sprite(PLAYER_SOURCE), PLAYER_WIDTH, PLAYER_HEIGHT, SHIP_KEY);
+    int shot_sprite = layout.add(Sprite(SHOT_SOURCE), SHOT_WIDTH, SHOT_HEIGHT);
+    int enemy_sprite = layout.add(Sprite(ENEMY_SOURCE), ENEMY_WIDTH, ENEMY_HEIGHT, SHIP_KEY);
+    int background_sprite = layout.add(
+        Sprite(GAME_BACKGROUND_SOURCE),
         GAME_BACKGROUND_WIDTH,
         GAME_BACKGROUND_HEIGHT
     );
     
+    // The scrolling background is initialised with layers of stars over it.
+    Sprite background(layout.get(background_sprite));
+    background.convert(display);
+    Starfield starfield(std::move(background), GAME_BACKGROUND_SPEED);
+    
+    for (int i = 0; i < STAR_LAYERS; ++i) {
+        starfield.add_layer(
+            STAR_COUNTS[i],
+            STAR_SPEEDS[i],
+            static_cast<int>(STAR_SIZES[i] * display.width()),
+            STAR_COLOUR
+        );
+    }
+    
     // The blank space is initialised.
     Rectangle blank(
         BLANK_X,
@@ -809,177 +1290,223 @@ void game(Display& display, const Renderer& renderer) noexcept {
         BLANK_HEIGHT
     );
     
-    // The play button is intialised.
-    Button play(
-        Sprite(
-            PLAY_BUTTON_SOURCE,
-            display,
-            BUTTON_WIDTH,
-            BUTTON_HEIGHT
-        ),
-        display,
-        PLAY_BUTTON_X,
-        BUTTON_Y
+    // The play area below the blank space is initialised.
+    Rectangle playfield(
+        BLANK_X,
+        BLANK_HEIGHT,
+        BLANK_WIDTH,
+        display.height() - BLANK_HEIGHT
     );
     
+    // The gameplay sprites are packed into an atlas.
+    Atlas atlas = pack_sprites(layout, background_sprite, display);
+    
+    // The ships and shot get collision masks from their opaque pixels.
+    Sprite::Mask player_mask(layout.get(player_sprite));
+    Sprite::Mask shot_mask(layout.get(shot_sprite));
+    Sprite::Mask enemy_mask(layout.get(enemy_sprite));
+    
+    // The play button is intialised.
+    Button play(atlas.get(play_sprite), display, PLAY_BUTTON_X, BUTTON_Y);
+    
     // The pause button is intialised.
-    Button pause(
-        Sprite(
-            PAUSE_BUTTON_SOURCE,
-            display,
-            BUTTON_WIDTH,
-            BUTTON_HEIGHT
-        ),
-        display,
-        PAUSE_BUTTON_X,
-        BUTTON_Y
-    );
+    Button pause(atlas.get(pause_sprite), display, PAUSE_BUTTON_X, BUTTON_Y);
     
     // The reset button is intialised.
-    Button reset(
-        Sprite(
-            RESET_BUTTON_SOURCE,
-            display,
-            BUTTON_WIDTH,
-            BUTTON_HEIGHT
-        ),
-        display,
-        RESET_BUTTON_X,
-        BUTTON_Y
-    );
+    Button reset(atlas.get(reset_sprite), display, RESET_BUTTON_X, BUTTON_Y);
     
     // The quit button is intialised.
-    Button quit(
-        Sprite(
-            QUIT_BUTTON_SOURCE,
-            display,
-            BUTTON_WIDTH,
-            BUTTON_HEIGHT
-        ),
-        display,
-        QUIT_BUTTON_X,
-        BUTTON_Y
-    );
+    Button quit(atlas.get(quit_sprite), display, QUIT_BUTTON_X, BUTTON_Y);
     
     // The player is initialised.
-    Player player(display);
+    Player player(
+        display,
+        renderer,
+        atlas.get(player_sprite),
+        atlas.get(shot_sprite),
+        player_mask,
+        shot_mask
+    );
     
     // The enemies are initialised.
-    Enemies enemies(display);
+    Enemies enemies(display, atlas.get(enemy_sprite), enemy_mask);
     
     // True if the game is paused.
     bool paused = false;
     
+    // True if the game is over and waiting for the reset or quit button.
+    bool over = false;
+    
+    // The time that the game was paused at.
+    double paused_at = 0;
+    
+    // True if the paused or game over screen must be drawn again, such as after a resize.
+    bool redraw = false;
+    
+    // The number of frames since the HUD was last forced to be redrawn.
+    // The HUD is redrawn for consecutive frames, so every display buffer gets it.
+    int frame = 0;
+    
     // Main game loop.
+    // While the game is paused or over, the game isn't advanced,
+    //   and it is only drawn when the window changes.
     while (true) {
-        // The display is blitted to.
-        display.blit(background, GAME_BACKGROUND_X, GAME_BACKGROUND_Y);
-        player.blit_shot(display);
-        enemies.blit_to(display);
-        display.fill(blank);
-        player.blit_to(display, renderer);
-        pause.blit_to(display);
-        reset.blit_to(display);
-        quit.blit_to(display);
-        
-        // The display is updated.
-        display.update();
+        // The window's events are updated, so that a resize is noticed.
+        Events::update();
         
-        // If the quit button was clicked, the game ends.
-        if (quit.get_rectangle().unclick()) {
-            break;
+        // If the window was resized, everything sized in pixels is resized with it,
+        //   except for the sprites, which keep their old sizes while they are rescaled.
+        if (display.resized()) {
+            blank = Rectangle(BLANK_X, BLANK_Y, BLANK_WIDTH, BLANK_HEIGHT);
+            playfield = Rectangle(BLANK_X, BLANK_HEIGHT, BLANK_WIDTH, display.height() - BLANK_HEIGHT);
+            layout.resize(display);
+            player.resize(display, renderer);
+            enemies.resize(display);
+            play = Button(atlas.get(play_sprite), display, PLAY_BUTTON_X, BUTTON_Y);
+            pause = Button(atlas.get(pause_sprite), display, PAUSE_BUTTON_X, BUTTON_Y);
+            reset = Button(atlas.get(reset_sprite), display, RESET_BUTTON_X, BUTTON_Y);
+            quit = Button(atlas.get(quit_sprite), display, QUIT_BUTTON_X, BUTTON_Y);
+            governor.skip();
+            frame = 0;
+            redraw = true;
         }
         
-        // If the reset button was clicked, the game state is reset.
-        else if (reset.get_rectangle().unclick()) {
-            player.reset();
-            enemies.reset();
-            continue;
+        // Once the sprites are rescaled, they are swapped in and packed again.
+        if (layout.update()) {
+            Sprite background(layout.get(background_sprite));
+            background.convert(display);
+            starfield.set_strip(std::move(background));
+            atlas = pack_sprites(layout, background_sprite, display);
+            player_mask = Sprite::Mask(layout.get(player_sprite));
+            shot_mask = Sprite::Mask(layout.get(shot_sprite));
+            enemy_mask = Sprite::Mask(layout.get(enemy_sprite));
+            player.set_sprites(atlas.get(player_sprite), atlas.get(shot_sprite), player_mask, shot_mask);
+            enemies.set_sprite(atlas.get(enemy_sprite), enemy_mask);
+            play = Button(atlas.get(play_sprite), display, PLAY_BUTTON_X, BUTTON_Y);
+            pause = Button(atlas.get(pause_sprite), display, PAUSE_BUTTON_X, BUTTON_Y);
+            reset = Button(atlas.get(reset_sprite), display, RESET_BUTTON_X, BUTTON_Y);
+            quit = Button(atlas.get(quit_sprite), display, QUIT_BUTTON_X, BUTTON_Y);
+            governor.skip();
+            redraw = true;
         }
         
-        // If the pause button was clicked, the game is paused.
-        else if (pause.get_rectangle().unclick()) {
-            // The time of pausing is recorded.
-            double now = Timer::time();
+        bool waiting = paused || over;
+        
+        if (!waiting || redraw) {
+            // The quality is adjusted to the last frame's time.
+            if (!waiting) {
+                governor.update(display.get_frame_time());
+                enemies.set_particle_ratio(governor.get_particle_ratio());
+                starfield.update(std::min(display.get_frame_time(), GAME_BACKGROUND_MAX_STEP));
+            }
             
-            // The play button is displayed.
-            play.blit_to(display);
-            display.update();
+            bool hud = waiting || frame++ % governor.get_hud_interval() < display.get_buffers();
             
-            // Defines the operation to be performed depending on the button pressed.
-            enum Operation {
-                PLAY,
-                RESET,
-                QUIT
-            } operation;
+            // The display is blitted to.
+            // Between HUD redraws, the play area is clipped to keep the HUD intact.
+            // Enemies outside of the play area are culled, as the HUD covers them.
+            if (governor.get_background()) {
+                starfield.blit_to(display, GAME_BACKGROUND_X, GAME_BACKGROUND_Y);
+            }
             
-            while (true) {
-                if (play.get_rectangle().unclick()) {
-                    operation = PLAY;
-                    break;
-                }
-                
-                else if (reset.get_rectangle().unclick()) {
-                    operation = RESET;
-                    break;
-                }
-                
-                else if (quit.get_rectangle().unclick()) {
-                    operation = QUIT;
-                    break;
-                }
-                
-                Events::update();
+            else {
+                display.fill(playfield);
             }
             
-            // The total time spent paused is recorded.
-            double elapsed = Timer::time() - now;
+            if (!hud) {
+                display.set_clip(playfield);
+            }
             
-            // The last_move times are shifted according to the pause time.
-            player.pause_shift(elapsed);
-            enemies.pause_shift(elapsed);
+            player.blit_shot(display);
+            enemies.blit_to(display, playfield);
             
-            if (operation == RESET) {
-                player.reset();
-                enemies.reset();
-                continue;
+            if (hud) {
+                display.fill(blank);
             }
             
-            else if (operation == QUIT) {
-                break;
+            else {
+                display.reset_clip();
             }
-        }
-        
-        // The player is updated.
-        // A true return value means that the game is over.
-        if (player.update(display.width(), enemies)) {
-            enum Operation {
-                RESET,
-                QUIT
-            } operation;
             
-            while (true) {
-                if (reset.get_rectangle().unclick()) {
-                    operation = RESET;
-                    break;
-                }
-                
-                else if (quit.get_rectangle().unclick()) {
-                    operation = QUIT;
-                    break;
-                }
-                
-                Events::update();
+            player.blit_to(display);
+            
+            if (hud) {
+                player.blit_score(display);
+                pause.blit_to(display);
+                reset.blit_to(display);
+                quit.blit_to(display);
             }
             
-            if (operation == RESET) {
-                player.reset();
-                enemies.reset();
+            // A paused game is darkened and the play button is displayed.
+            // The buttons are blitted again, so that they still look clickable.
+            if (paused) {
+                display.fade(PAUSE_FADE);
+                reset.blit_to(display);
+                quit.blit_to(display);
+                play.blit_to(display);
             }
             
-            else if (operation == QUIT) {
-                break;
+            // The frame is captured and the display is updated.
+            if (!waiting) {
+                recorder.record(display);
+            }
+            
+            display.update();
+            redraw = false;
+        }
+        
+        // If the quit button was clicked, the game ends.
+        if (quit.get_rectangle().unclick()) {
+            break;
+        }
+        
+        // If the reset button was clicked, the game state is reset.
+        // The time spent paused isn't counted, and the HUD is redrawn.
+        else if (reset.get_rectangle().unclick()) {
+            if (paused) {
+                double elapsed = Timer::time() - paused_at;
+                player.pause_shift(elapsed);
+                enemies.pause_shift(elapsed);
             }
+            
+            player.reset();
+            enemies.reset();
+            governor.skip();
+            frame = 0;
+            paused = false;
+            over = false;
+            continue;
+        }
+        
+        // If the play button was clicked while paused, the game resumes.
+        // The time spent paused isn't counted, and the HUD is redrawn.
+        else if (paused && play.get_rectangle().unclick()) {
+            double elapsed = Timer::time() - paused_at;
+            player.pause_shift(elapsed);
+            enemies.pause_shift(elapsed);
+            governor.skip();
+            frame = 0;
+            paused = false;
+            continue;
+        }
+        
+        // If the pause button was clicked, the game is paused.
+        else if (!waiting && pause.get_rectangle().unclick()) {
+            paused_at = Timer::time();
+            paused = true;
+            redraw = true;
+            continue;
+        }
+        
+        if (waiting) {
+            continue;
+        }
+        
+        // The player is updated.
+        // A true return value means that the game is over.
+        if (player.update(display.width(), enemies)) {
+            over = true;
+            continue;
         }
         
         // The enemies are updated.
@@ -987,6 +1514,27 @@ void game(Display& display, const Renderer& renderer) noexcept {
         
         Events::update();
     }
+    
+    // The menu is rendered at the default scale.
+    display.set_scale(RENDER_SCALE);
+}
+
+/**
+ * Returns the key of the menu's cache for the given display,
+ *   continuing from the given hash of the menu's assets.
+ * The key changes with the display's size and format and the versions.
+ */
+Uint64 menu_cache_key(const Sprite& display, Uint64 assets) noexcept {
+    Uint32 size[] = {
+        static_cast<Uint32>(display.width()),
+        static_cast<Uint32>(display.height()),
+        display.get_pixel_format()
+    };
+    
+    Uint64 key = SpriteCache::hash(size, sizeof(size), assets);
+    key = SpriteCache::hash_string(System::version(VERSION), key);
+    
+    return SpriteCache::hash_string(System::version(), key);
 }
 
 /**
@@ -1021,6 +1569,15 @@ void display_help(Display& display, const Renderer& renderer) noexcept {
     }
 }
 
+/**
+ * Returns true if the game is running on a platform whose window surfaces
+ *   are plain framebuffers, which can be updated from any thread.
+ * Other platforms back them with a renderer of the main thread.
+ */
+bool framebuffer_platform() {
+    return std::string(SDL_GetPlatform()) == "Windows";
+}
+
 /**
  * Initialises the utilities and loads the main menu.
  * Allows access to the main game and the help message.
@@ -1033,113 +1590,144 @@ int main(int argc, char** argv) {
     {
         // The display is initialised.
         Display display;
+        display.set_scale(RENDER_SCALE);
+        display.set_backend(PRESENT_BACKEND);
+        display.set_asynchronous(ASYNCHRONOUS_PRESENT && framebuffer_platform());
+        display.set_resizable(RESIZABLE_WINDOW);
+        
+        // The quality governor is initialised and kept between games.
+        Governor governor(1 / TARGET_RATE);
+        
+        // The gameplay recorder is initialised.
+        Recorder recorder(CAPTURE_DESTINATION, display);
         
         // The audio is intialised and queued in another thread.
         AudioThread audio(AUDIO_SOURCE, AUDIO_LENGTH);
         
-        // The characters and sources for the renderer are intialised.
+        // The characters for the renderer are intialised.
         std::array<char, RENDERER_COUNT> characters;
-        std::array<std::string, RENDERER_COUNT> sources;
-        
-        //     The directory is set.
-        for (int i = 0; i < RENDERER_COUNT; ++i) {
-            sources[i] = RENDERER_DIRECTORY;
-        }
         
         //     The lowercase letters are set.
         for (int i = 0; i < RENDERER_LETTERS; ++i) {
             characters[i] = 'a' + i;
-            sources[i] += 'a' + i;
         }
         
         //     The uppercase letters are set.
         for (int i = 0; i < RENDERER_LETTERS; ++i) {
             characters[RENDERER_LETTERS + i] = 'A' + i;
-            sources[RENDERER_LETTERS + i] += 'a' + i;
         }
         
         //     The numbers are set.
         for (int i = 0; i < RENDERER_NUMBERS; ++i) {
             characters[RENDERER_CASES * RENDERER_LETTERS + i] = '0' + i;
-            sources[RENDERER_CASES * RENDERER_LETTERS + i] += '0' + i;
         }
         
         //     The punctuation is set.
         for (int i = 0; i < RENDERER_EXTRAS; ++i) {
             characters[RENDERER_EXTRA_INDEX + i] = RENDERER_EXTRA_CHARACTERS[i];
-            sources[RENDERER_EXTRA_INDEX + i] += RENDERER_EXTRA_SOURCES[i];
-        }
-        
-        //     The file extension is set.
-        for (int i = 0; i < RENDERER_COUNT; ++i) {
-            sources[i] += RENDERER_EXTENSION;
         }
         
         // The renderer is initialised.
-        const Renderer& renderer = FullRenderer<RENDERER_COUNT>(characters, sources);
-        
-        // The background is initialised.
-        Sprite background(MENU_BACKGROUND_SOURCE);
-        
-        // The title is initialised.
-        Sprite title(
-            renderer.lined_render(
-                display,
-                TITLE_STRING,
-                TITLE_WIDTH,
-                TITLE_HEIGHT,
-                TITLE_X_SEPARATION,
-                TITLE_Y_SEPARATION
-            )
+        const Renderer& renderer = SdfRenderer<RENDERER_COUNT>(
+            characters,
+            RENDERER_SOURCE,
+            RENDERER_COLOUR
         );
         
-        // The play button is initialised.
-        Button play(
-            renderer.render(
-                display,
-                PLAY_STRING,
-                PLAY_WIDTH,
-                PLAY_HEIGHT,
-                PLAY_SEPARATION
-            ),
-            display,
-            PLAY_X,
-            PLAY_Y
-        );
+        // The menu is cached in the application's storage, unless there is none.
+        std::string cache_path = System::storage(CACHE_ORGANISATION, CACHE_APPLICATION);
         
-        // The help button is intialised.
-        Button help(
-            renderer.render(
-                display,
-                HELP_STRING,
-                HELP_WIDTH,
-                HELP_HEIGHT,
-                HELP_SEPARATION
-            ),
-            display,
-            HELP_X,
-            HELP_Y
-        );
+        if (!cache_path.empty() && *MENU_CACHE_NAME) {
+            cache_path += MENU_CACHE_NAME;
+        }
         
-        // The info sprite is initialised.
-        Sprite info(
-            renderer.lined_render(
-                display,
-                INFO_STRING,
-                INFO_WIDTH,
-                INFO_HEIGHT,
-                INFO_X_SEPARATION,
-                INFO_Y_SEPARATION,
-                INFO_MAX_WIDTH,
-                INFO_JUSTIFICATION
-            )
-        );
+        else {
+            cache_path.clear();
+        }
+        
+        // The menu's assets are hashed once, for the cache's key.
+        Uint64 assets = SpriteCache::hash_file(MENU_BACKGROUND_SOURCE, SpriteCache::hash_file(RENDERER_SOURCE));
         
         // True when the program should prepare for termination.
         bool end = false;
         
         // Loop to blit sprites to the display.
         while (!end) {
+            // The menu is laid out each time it is shown,
+            //   so that it follows the window's size.
+            // Each sprite is read from the cache, if it was saved for this size,
+            //   and is rendered and saved otherwise.
+            SpriteCache cache(cache_path, menu_cache_key(display, assets));
+            
+            // The background is initialised at the display's size.
+            Sprite background = cache.fetch([&display] {
+                Sprite background(MENU_BACKGROUND_SOURCE, display, 1, 1);
+                background.convert(display);
+                
+                return background;
+            });
+            
+            // The title is initialised.
+            Sprite title = cache.fetch([&display, &renderer] {
+                return renderer.lined_render(
+                    display,
+                    TITLE_STRING,
+                    TITLE_WIDTH,
+                    TITLE_HEIGHT,
+                    TITLE_X_SEPARATION,
+                    TITLE_Y_SEPARATION
+                );
+            });
+            
+            // The play button is initialised.
+            Button play(
+                cache.fetch([&display, &renderer] {
+                    return renderer.render(
+                        display,
+                        PLAY_STRING,
+                        PLAY_WIDTH,
+                        PLAY_HEIGHT,
+                        PLAY_SEPARATION
+                    );
+                }),
+                display,
+                PLAY_X,
+                PLAY_Y
+            );
+            
+            // The help button is intialised.
+            Button help(
+                cache.fetch([&display, &renderer] {
+                    return renderer.render(
+                        display,
+                        HELP_STRING,
+                        HELP_WIDTH,
+                        HELP_HEIGHT,
+                        HELP_SEPARATION
+                    );
+                }),
+                display,
+                HELP_X,
+                HELP_Y
+            );
+            
+            // The info sprite is initialised.
+            Sprite info = cache.fetch([&display, &renderer] {
+                return renderer.lined_render(
+                    display,
+                    INFO_STRING,
+                    INFO_WIDTH,
+                    INFO_HEIGHT,
+                    INFO_X_SEPARATION,
+                    INFO_Y_SEPARATION,
+                    INFO_MAX_WIDTH,
+                    INFO_JUSTIFICATION
+                );
+            });
+            
+            // The cache is closed, so that a rebuilt cache is written before play.
+            cache.close();
+            
             // The display is blitted to.
             display.blit(background);
             display.blit(title, TITLE_X, TITLE_Y);
@@ -1166,7 +1754,12 @@ int main(int argc, char** argv) {
                 
                 // Play starts the game.
                 else if (play.get_rectangle().unclick()) {
-                    game(display, renderer);
+                    game(display, renderer, governor, recorder);
+                    break;
+                }
+                
+                // A resize lays the menu out again.
+                else if (display.resized()) {
                     break;
                 }
                 
@@ -1187,6 +1780,29 @@ int main(int argc, char** argv) {
 //}
 
 /* CHANGELOG:
+     v1.2:
+       Text is rendered from a distance field atlas, instead of a BMP per character.
+       The gameplay sprites are packed into an atlas.
+       The gameplay sprites are stored in high colour on high colour displays.
+       The backgrounds are converted to the display's pixel format.
+       The ships' black backgrounds are transparent and skipped when blitted.
+       Enemies trail exhaust particles and explode when they are shot.
+       The game can render below the window's resolution.
+       A governor sheds particles, HUD redraws, the background and the render scale
+         when frames run over budget and restores them when there is headroom.
+       Frames can be presented on a separate thread on Windows.
+       Gameplay frames can be captured to disk.
+       Enemies outside of the play area are culled instead of blitted.
+       The game is darkened while it is paused.
+       The window can be resized, or rotated, during a game, even while it is paused or over,
+         and the gameplay sprites are rescaled in the background.
+       Frames can be presented through SDL_Renderer.
+       Shots and collisions with the player are tested against the sprites' opaque pixels.
+       The main menu's renderings are cached on disk, so later launches skip rendering them.
+       The gameplay sprites are blitted by kernels specialised for their format and width.
+       The game background scrolls under layers of stars.
+       Captures can be exported as raw video by the capturevideo tool.
+       The score is displayed with a Counter instead of being rendered every frame.
      v1.1:
        Multiple threads are used to update enemies.
        The oldest enemy is checked first for shot contact.